@@ -0,0 +1,27 @@
+#pragma once
+#include <vector>
+#include <complex>
+
+// Iterative radix-2 fast Fourier transform,
+// the sizes have to be powers of two
+class FFT
+{
+public:
+	// Transforms the grid (width values per row) in place, the inverse
+	// transform is scaled so it undoes the forward one
+	void transform_2d(std::vector<std::complex<float>>& data, int width, int height, bool inverse);
+	// Smallest power of two not below n
+	static int size_for(int n);
+	// Spelled out, the operator checks for infinities and is far slower
+	static std::complex<float> multiply(std::complex<float> a, std::complex<float> b)
+	{
+		return std::complex<float>(a.real() * b.real() - a.imag() * b.imag(),
+			a.real() * b.imag() + a.imag() * b.real());
+	}
+private:
+	// exp(-2 pi i k / n) for the largest size used so far,
+	// smaller sizes take every (n / size)th one
+	std::vector<std::complex<float>> twiddles;
+	std::vector<std::complex<float>> column;
+	void transform(std::complex<float>* data, int n, bool inverse);
+};
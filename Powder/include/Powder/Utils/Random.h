@@ -17,8 +17,10 @@ private:
 	// seed
 	uint64_t s[2];
 	uint64_t next();
-	static uint32_t next_uint32_temp;
-	static bool has_next_uint32;
+	uint32_t next_uint32_temp;
+	bool has_next_uint32;
 };
-extern Random random;
+// Every thread gets its own generator so the particle
+// updates can run on several threads
+extern thread_local Random random;
 
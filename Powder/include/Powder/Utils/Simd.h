@@ -0,0 +1,57 @@
+#pragma once
+
+// Thin wrappers over the widest float vectors the compiler targets,
+// AVX with /arch:AVX (or -mavx), SSE on x64 and Win32 with SSE2,
+// plain floats elsewhere. Only what the grid kernels need is here,
+// loads and stores are unaligned.
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define SIMD_WIDTH 8
+typedef __m256 simd_float;
+inline simd_float simd_load(const float* p) { return _mm256_loadu_ps(p); }
+inline void simd_store(float* p, simd_float a) { _mm256_storeu_ps(p, a); }
+inline simd_float simd_set(float f) { return _mm256_set1_ps(f); }
+inline simd_float simd_add(simd_float a, simd_float b) { return _mm256_add_ps(a, b); }
+inline simd_float simd_sub(simd_float a, simd_float b) { return _mm256_sub_ps(a, b); }
+inline simd_float simd_mul(simd_float a, simd_float b) { return _mm256_mul_ps(a, b); }
+inline simd_float simd_min(simd_float a, simd_float b) { return _mm256_min_ps(a, b); }
+inline simd_float simd_max(simd_float a, simd_float b) { return _mm256_max_ps(a, b); }
+inline simd_float simd_div(simd_float a, simd_float b) { return _mm256_div_ps(a, b); }
+// All bits set in the lanes where a > b, used by simd_select
+inline simd_float simd_greater(simd_float a, simd_float b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+// a in the lanes set in mask, b in the others
+inline simd_float simd_select(simd_float mask, simd_float a, simd_float b) { return _mm256_blendv_ps(b, a, mask); }
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SIMD_WIDTH 4
+typedef __m128 simd_float;
+inline simd_float simd_load(const float* p) { return _mm_loadu_ps(p); }
+inline void simd_store(float* p, simd_float a) { _mm_storeu_ps(p, a); }
+inline simd_float simd_set(float f) { return _mm_set1_ps(f); }
+inline simd_float simd_add(simd_float a, simd_float b) { return _mm_add_ps(a, b); }
+inline simd_float simd_sub(simd_float a, simd_float b) { return _mm_sub_ps(a, b); }
+inline simd_float simd_mul(simd_float a, simd_float b) { return _mm_mul_ps(a, b); }
+inline simd_float simd_min(simd_float a, simd_float b) { return _mm_min_ps(a, b); }
+inline simd_float simd_max(simd_float a, simd_float b) { return _mm_max_ps(a, b); }
+inline simd_float simd_div(simd_float a, simd_float b) { return _mm_div_ps(a, b); }
+inline simd_float simd_greater(simd_float a, simd_float b) { return _mm_cmpgt_ps(a, b); }
+inline simd_float simd_select(simd_float mask, simd_float a, simd_float b)
+{
+	return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+#else
+#define SIMD_WIDTH 1
+typedef float simd_float;
+inline simd_float simd_load(const float* p) { return *p; }
+inline void simd_store(float* p, simd_float a) { *p = a; }
+inline simd_float simd_set(float f) { return f; }
+inline simd_float simd_add(simd_float a, simd_float b) { return a + b; }
+inline simd_float simd_sub(simd_float a, simd_float b) { return a - b; }
+inline simd_float simd_mul(simd_float a, simd_float b) { return a * b; }
+inline simd_float simd_min(simd_float a, simd_float b) { return b < a ? b : a; }
+inline simd_float simd_max(simd_float a, simd_float b) { return a < b ? b : a; }
+inline simd_float simd_div(simd_float a, simd_float b) { return a / b; }
+inline simd_float simd_greater(simd_float a, simd_float b) { return a > b ? 1.0f : 0.0f; }
+inline simd_float simd_select(simd_float mask, simd_float a, simd_float b) { return mask != 0.0f ? a : b; }
+#endif
@@ -0,0 +1,43 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+
+// A fixed set of threads that run the same job over a range of indices.
+// The calling thread takes part in every job as worker 0,
+// so a pool of one thread runs everything inline.
+class ThreadPool
+{
+public:
+	// Index of the worker running on the current thread,
+	// -1 outside of run
+	static thread_local int worker;
+	// Calls job(i) for every i in [0, count) spread over the workers,
+	// returns once all of them are done
+	void run(int count, const std::function<void(int)>& job);
+	// Amount of workers, the calling thread included
+	void set_thread_count(int count);
+	int get_thread_count() const;
+	ThreadPool(int thread_count);
+	~ThreadPool();
+private:
+	std::vector<std::thread> threads;
+	std::mutex mutex;
+	std::condition_variable start_cv, done_cv;
+	const std::function<void(int)>* job;
+	int job_count;
+	std::atomic<int> next_index;
+	// Threads still working on the current job
+	int busy;
+	// Incremented for every job so the threads notice a new one
+	unsigned int generation;
+	bool stopping;
+	// seen is the last job the thread doesn't have to run
+	void thread_loop(int index, unsigned int seen);
+	// Takes indices until none are left
+	void work();
+	void stop();
+};
@@ -1,7 +1,6 @@
 #include <SFML/Graphics.hpp>
 #include <iostream>
 #include "Simulation.h"
-#include "Element/ElementIncludes.h"
 #include "Brushes/CircleBrush.h"
 #include "Brushes/SquareBrush.h"
 #include "Utils/Vector.h"
@@ -14,30 +13,6 @@ int main()
 	window.setVerticalSyncEnabled(true);
 	ImGui::SFML::Init(window);
 	Simulation sim(160, 90, WINDOW_WIDTH, WINDOW_HEIGHT, 9.8f);
-	// TODO make the generate script do this
-	sim.add_element(std::make_shared<WALL>(sim));
-	sim.add_element(std::make_shared<Acid>(sim));
-	sim.add_element(std::make_shared<BHOL>(sim));
-	sim.add_element(std::make_shared<Brick>(sim));
-	sim.add_element(std::make_shared<Caus>(sim));
-	sim.add_element(std::make_shared<Coal>(sim));
-	sim.add_element(std::make_shared<Dust>(sim));
-	sim.add_element(std::make_shared<EXC4>(sim));
-	sim.add_element(std::make_shared<Fire>(sim));
-	sim.add_element(std::make_shared<Gas>(sim));
-	sim.add_element(std::make_shared<Gold>(sim));
-	sim.add_element(std::make_shared<Gun>(sim));
-	sim.add_element(std::make_shared<Ice>(sim));
-	sim.add_element(std::make_shared<Lava>(sim));
-	sim.add_element(std::make_shared<Metl>(sim));
-	sim.add_element(std::make_shared<Nitr>(sim));
-	sim.add_element(std::make_shared<Oil>(sim));
-	sim.add_element(std::make_shared<Sand>(sim));
-	sim.add_element(std::make_shared<Stone>(sim));
-	sim.add_element(std::make_shared<Water>(sim));
-	sim.add_element(std::make_shared<WHOL>(sim));
-	sim.add_element(std::make_shared<Wood>(sim));
-	sim.add_element(std::make_shared<Wtrv>(sim));
 	sim.add_brush(std::make_shared<CircleBrush>());
 	sim.add_brush(std::make_shared<SquareBrush>());
 	sim.add_tool(std::make_shared<SpawnTool>());
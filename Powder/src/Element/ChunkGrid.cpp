@@ -0,0 +1,139 @@
+#include "ChunkGrid.h"
+#include "Utils/ThreadPool.h"
+#include <algorithm>
+#include <climits>
+
+void CellRect::clear()
+{
+	min_x = min_y = INT_MAX;
+	max_x = max_y = INT_MIN;
+}
+
+void CellRect::expand(int x0, int y0, int x1, int y1)
+{
+	min_x = std::min(min_x, x0);
+	min_y = std::min(min_y, y0);
+	max_x = std::max(max_x, x1);
+	max_y = std::max(max_y, y1);
+}
+
+void CellRect::expand(const CellRect& other)
+{
+	if (!other.empty())
+		expand(other.min_x, other.min_y, other.max_x, other.max_y);
+}
+
+void ChunkGrid::wake(int x, int y)
+{
+	wake_area(x, y, x, y);
+}
+
+void ChunkGrid::wake_area(int x0, int y0, int x1, int y1)
+{
+	x0 = std::max(x0 - CHUNK_WAKE_RADIUS, 0);
+	y0 = std::max(y0 - CHUNK_WAKE_RADIUS, 0);
+	x1 = std::min(x1 + CHUNK_WAKE_RADIUS, cells_x - 1);
+	y1 = std::min(y1 + CHUNK_WAKE_RADIUS, cells_y - 1);
+	if (x0 > x1 || y0 > y1)
+		return;
+	for (int cy = y0 >> CHUNK_SIZE_LOG2; cy <= y1 >> CHUNK_SIZE_LOG2; cy++)
+	{
+		for (int cx = x0 >> CHUNK_SIZE_LOG2; cx <= x1 >> CHUNK_SIZE_LOG2; cx++)
+		{
+			// the part of the area inside this chunk
+			int rx0 = std::max(x0, cx << CHUNK_SIZE_LOG2);
+			int ry0 = std::max(y0, cy << CHUNK_SIZE_LOG2);
+			int rx1 = std::min(x1, ((cx + 1) << CHUNK_SIZE_LOG2) - 1);
+			int ry1 = std::min(y1, ((cy + 1) << CHUNK_SIZE_LOG2) - 1);
+			if (ThreadPool::worker >= 0)
+			{
+				// another worker might be waking the same chunk
+				deferred[ThreadPool::worker][cy * width + cx].expand(rx0, ry0, rx1, ry1);
+				continue;
+			}
+			Chunk& chunk = chunks[cy * width + cx];
+			chunk.dirty.expand(rx0, ry0, rx1, ry1);
+			chunk.active.expand(rx0, ry0, rx1, ry1);
+			chunk.idle_ticks = 0;
+		}
+	}
+}
+
+void ChunkGrid::wake_all()
+{
+	wake_area(0, 0, cells_x - 1, cells_y - 1);
+}
+
+void ChunkGrid::begin_tick()
+{
+	for (auto& chunk : chunks)
+	{
+		if (chunk.dirty.empty())
+		{
+			if (!chunk.active.empty() && ++chunk.idle_ticks >= CHUNK_SLEEP_TICKS)
+				chunk.active.clear();
+		}
+		else
+		{
+			chunk.idle_ticks = 0;
+			chunk.dirty.clear();
+		}
+	}
+}
+
+void ChunkGrid::merge_deferred()
+{
+	for (auto& rects : deferred)
+	{
+		for (size_t i = 0; i < chunks.size(); i++)
+		{
+			if (rects[i].empty())
+				continue;
+			chunks[i].dirty.expand(rects[i]);
+			chunks[i].active.expand(rects[i]);
+			chunks[i].idle_ticks = 0;
+			rects[i].clear();
+		}
+	}
+}
+
+void ChunkGrid::set_worker_count(int count)
+{
+	merge_deferred();
+	CellRect rect;
+	rect.clear();
+	deferred.assign(count, std::vector<CellRect>(chunks.size(), rect));
+}
+
+int ChunkGrid::awake_count() const
+{
+	int count = 0;
+	for (auto& chunk : chunks)
+		if (!chunk.active.empty())
+			count++;
+	return count;
+}
+
+void ChunkGrid::resize(int cells_x, int cells_y)
+{
+	this->cells_x = cells_x;
+	this->cells_y = cells_y;
+	width = (cells_x + CHUNK_SIZE - 1) >> CHUNK_SIZE_LOG2;
+	height = (cells_y + CHUNK_SIZE - 1) >> CHUNK_SIZE_LOG2;
+	Chunk chunk;
+	chunk.dirty.clear();
+	chunk.active.clear();
+	chunk.idle_ticks = 0;
+	chunks.assign(width * height, chunk);
+	for (auto& rects : deferred)
+		rects.assign(chunks.size(), chunk.dirty);
+}
+
+ChunkGrid::ChunkGrid(int cells_x, int cells_y)
+{
+	resize(cells_x, cells_y);
+}
+
+ChunkGrid::~ChunkGrid()
+{
+}
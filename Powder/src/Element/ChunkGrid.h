@@ -0,0 +1,89 @@
+#pragma once
+#include <vector>
+
+// Size of a chunk in cells, a power of two so the chunk
+// of a cell can be found with a shift
+#define CHUNK_SIZE_LOG2 5
+#define CHUNK_SIZE (1 << CHUNK_SIZE_LOG2)
+// Ticks a chunk has to go without activity before it falls asleep
+#define CHUNK_SLEEP_TICKS 8
+// How far from a touched cell particles are woken up,
+// GOL births are decided by cells two steps away
+#define CHUNK_WAKE_RADIUS 2
+// Temperature change (in kelvins) during a tick that counts as activity
+#define CHUNK_HEAT_EPS 0.001f
+// Change in air pressure or air velocity that counts as activity
+#define CHUNK_AIR_EPS 0.001f
+// Cells a particle can travel during a single move, keeps everything
+// a particle touches in a tick within CHUNK_SIZE / 2 of its chunk
+// so chunks two apart can be updated on different threads
+#define CHUNK_MAX_MOVE 10
+
+// Inclusive rectangle of cells, empty when min_x > max_x
+struct CellRect
+{
+	int min_x, min_y, max_x, max_y;
+	bool empty() const { return min_x > max_x; }
+	bool contains(int x, int y) const
+	{
+		return x >= min_x && x <= max_x && y >= min_y && y <= max_y;
+	}
+	void clear();
+	void expand(int x0, int y0, int x1, int y1);
+	void expand(const CellRect& other);
+};
+
+struct Chunk
+{
+	// Cells touched since the start of the current tick
+	CellRect dirty;
+	// Cells whose particles are updated, the dirty rects gathered
+	// since the chunk woke up, empty while the chunk sleeps
+	CellRect active;
+	// Ticks in a row without a touched cell
+	int idle_ticks;
+};
+
+// Divides the element grid into chunks that keep track of where
+// something happened, particles outside of the active rect
+// of their chunk are not updated.
+// Anything that changes a particle (moving, heat, transitions, tools...)
+// has to wake the cell through wake, otherwise its neighbours
+// might stay asleep.
+// Wakes made by the workers of a ThreadPool are kept per worker
+// and only reach the chunks through merge_deferred.
+class ChunkGrid
+{
+public:
+	int width, height; // Amount of chunks
+	std::vector<Chunk> chunks;
+	// Marks the cell and the cells around it as touched
+	void wake(int x, int y);
+	// Marks every cell inside the inclusive rectangle as touched
+	void wake_area(int x0, int y0, int x1, int y1);
+	void wake_all();
+	// Called at the start of every tick, chunks without
+	// any touched cell since the last call count as idle
+	void begin_tick();
+	// Index of the chunk the cell belongs to
+	int index_of(int x, int y) const
+	{
+		return (y >> CHUNK_SIZE_LOG2) * width + (x >> CHUNK_SIZE_LOG2);
+	}
+	bool is_active(int x, int y) const
+	{
+		return chunks[index_of(x, y)].active.contains(x, y);
+	}
+	int awake_count() const;
+	// Applies the wakes the workers made since the last call
+	void merge_deferred();
+	void set_worker_count(int count);
+	void resize(int cells_x, int cells_y);
+	ChunkGrid(int cells_x, int cells_y);
+	~ChunkGrid();
+private:
+	int cells_x, cells_y;
+	// Touched cells of every chunk for each worker
+	std::vector<std::vector<CellRect>> deferred;
+};
+
@@ -3,53 +3,50 @@
 #include "Utils/Random.h"
 #include <math.h>
 
-void Element::element_copy(const Element & rhs)
+ElementType& Element::type() const
 {
-	identifier = rhs.identifier;
-	name = rhs.name;
-	description = rhs.description;
-	colors = rhs.colors;
-	color = rhs.color;
-	set_pos(rhs.x, rhs.y, true);
-	gas_gravity = rhs.gas_gravity;
-	gas_pressure = rhs.gas_pressure;
-	mass = rhs.mass;
-	endurance = rhs.endurance;
-	life = rhs.life;
-	restitution = rhs.restitution;
-	pile_threshold = rhs.pile_threshold;
-	temperature = rhs.temperature;
-	thermal_cond = rhs.thermal_cond;
-	specific_heat_cap = rhs.specific_heat_cap;
-	state = rhs.state;
-	prop = rhs.prop;
-	low_pressure_transition = rhs.low_pressure_transition;		
-	high_pressure_transition = rhs.high_pressure_transition;
-	low_temperature_transition = rhs.low_temperature_transition;	
-	high_temperature_transition = rhs.high_temperature_transition;	
-	low_pressure = rhs.low_pressure;    
-	high_pressure = rhs.high_pressure;	
-	low_temperature = rhs.low_temperature;
-	high_temperature = rhs.high_temperature;
-	pile_threshold = rhs.pile_threshold;
-	flammability = rhs.flammability;
-	spontaneous_combustion_tmp = rhs.spontaneous_combustion_tmp;
-	melting_temperature = rhs.melting_temperature;
-	br_pressure = rhs.br_pressure;
+	return sim->element_types[identifier];
 }
 
-void Element::move(Vector dest)
+void Element::init_particle(int p)
 {
-	collision = false;
-	pos = dest;
-	collided_elem = EL_NONE;
-	ground_coll.Zero();
+	ParticleStore& ps = sim->particles;
+	const ElementType& t = type();
+	ps.color[p] = static_cast<uint8_t>(random.between(0, t.colors.size() - 1));
+	ps.mass[p] = t.mass;
+	ps.life[p] = t.life;
+	ps.temperature[p] = t.temperature;
+	ps.state[p] = t.state;
+	ps.prop[p] = t.prop;
+}
+
+void Element::move(int p, Vector dest)
+{
+	ParticleStore& ps = sim->particles;
+	Vector old_pos = ps.get_pos(p);
+	if (sim->split_tick)
+	{
+		// going further could touch cells another thread is updating
+		float max_move = static_cast<float>(CHUNK_MAX_MOVE);
+		dest.x = std::clamp(dest.x, ps.x[p] - max_move, ps.x[p] + max_move);
+		dest.y = std::clamp(dest.y, ps.y[p] - max_move, ps.y[p] + max_move);
+	}
+	ps.flags[p] &= ~PF_COLLISION;
+	ps.pos_x[p] = dest.x;
+	ps.pos_y[p] = dest.y;
+	ps.collided[p] = PT_NONE;
+	ps.coll_x[p] = 0;
+	ps.coll_y[p] = 0;
+	int x = ps.x[p], y = ps.y[p];
 	int xD = static_cast<int>(ceil(dest.x));
 	int yD = static_cast<int>(ceil(dest.y));
-	int old_x = x;
-	int old_y = y;
 	if (x == xD && y == yD)
+	{
+		// moving inside the cell keeps the chunk awake too
+		if (dest.x != old_pos.x || dest.y != old_pos.y)
+			sim->chunks.wake(x, y);
 		return;
+	}
 	int xStep, yStep;
 	int dx = xD - x;
 	int dy = yD - y;
@@ -76,18 +73,19 @@ void Element::move(Vector dest)
 	// we check if the slope is in the 1st 4th 5th and 8th octant
 	if (ddx >= ddy)
 	{
-		move_helper(x, y, dx, xStep, yStep, ddx, ddy, false);
+		move_helper(p, x, y, dx, xStep, yStep, ddx, ddy, false);
 	}
 	else // if its in the other 4 octants
 	{
-		move_helper(x, y, dy, xStep, yStep, ddy, ddx, true);
+		move_helper(p, x, y, dy, xStep, yStep, ddy, ddx, true);
 	}
-	if(sim)
-		sim->gravity.update_mass(mass, x, y, old_x, old_y);
+	if (ps.pos_x[p] != old_pos.x || ps.pos_y[p] != old_pos.y)
+		sim->chunks.wake(ps.x[p], ps.y[p]);
 }
 
-void Element::move_helper(int xO, int yO, int d, int xStep, int yStep, int de, int dr, bool ytype)
+void Element::move_helper(int p, int xO, int yO, int d, int xStep, int yStep, int de, int dr, bool ytype)
 {
+	ParticleStore& ps = sim->particles;
 	int eprev = d, e = d;
 	int diff_x, diff_y;
 	for (int i = 0; i < d; i++)
@@ -102,310 +100,348 @@ void Element::move_helper(int xO, int yO, int d, int xStep, int yStep, int de, i
 			{
 				diff_x = xO - (ytype ? xStep : 0);
 				diff_y = yO - (!ytype ? yStep : 0);
-				do_move(diff_x, diff_y);
-				if (collision)
+				do_move(p, diff_x, diff_y);
+				if (ps.flags[p] & PF_COLLISION)
 					break;
 			}
 			else if (e + eprev > de) // left corner
 			{
 				diff_x = xO - (!ytype ? xStep : 0);
 				diff_y = yO - (ytype ? yStep : 0);
-				do_move(diff_x, diff_y);
-				if (collision)
+				do_move(p, diff_x, diff_y);
+				if (ps.flags[p] & PF_COLLISION)
 					break;
 			}
 			else //the corner case
 			{
-				if (collision)
+				if (ps.flags[p] & PF_COLLISION)
 					break;
 			}
 		}
-		do_move(xO, yO);
-		if (collision)
+		do_move(p, xO, yO);
+		if (ps.flags[p] & PF_COLLISION)
 			break;
 		eprev = e;
-		moved = true;
+		ps.flags[p] |= PF_MOVED;
 	}
 }
 
-void Element::do_move(int diff_x, int diff_y)
+void Element::do_move(int p, int diff_x, int diff_y)
 {
-	if (sim)
+	ParticleStore& ps = sim->particles;
+	if (!sim->bounds_check(diff_x, diff_y))
+	{
+		ps.coll_x[p] = diff_x;
+		ps.coll_y[p] = diff_y;
+		ps.set_pos(p, ps.x[p], ps.y[p], true);
+		ps.flags[p] |= PF_COLLISION;
+	}
+	else
 	{
-		if (!sim->bounds_check(diff_x, diff_y))
+		int coll = sim->get_from_grid(diff_x, diff_y);
+		ps.collided[p] = coll;
+		// if there is no collision we update the elements real coordinates
+		int res = eval_col(p, coll);
+		if (res == C_BLOCK)
 		{
-			ground_coll.x = static_cast<float> (diff_x);
-			ground_coll.y = static_cast<float> (diff_y);
-			set_pos(x, y, true);
-			collision = true;
+			ps.set_pos(p, ps.x[p], ps.y[p], true);
+			ps.flags[p] |= PF_COLLISION;
 		}
-		else
+		else if(res == C_SWAP)
 		{
-			collided_elem = &*(sim->get_from_grid(diff_x, diff_y));
-			// if there is no collision we update the elements real coordinates
-			int res = eval_col(collided_elem);
-			if (res == C_BLOCK)
-			{
-				set_pos(x, y, true);
-				collision = true;
-			}
-			else if(res == C_SWAP)
-			{
-				sim->swap_elements(x, y, diff_x, diff_y);
-				collided_elem = EL_NONE;
-			}
+			sim->swap_elements(ps.x[p], ps.y[p], diff_x, diff_y);
+			ps.collided[p] = PT_NONE;
 		}
 	}
 }
 
 
-int Element::eval_col(Element* coll_el)
+int Element::eval_col(int p, int coll)
 {
-	if (coll_el == EL_NONE)
+	if (coll == PT_NONE)
 		return C_SWAP;
-	if (coll_el->state == state)
-		return mass > coll_el->mass ? C_SWAP : C_BLOCK;
+	const ParticleStore& ps = sim->particles;
+	if (ps.state[coll] == ps.state[p])
+		return ps.mass[p] > ps.mass[coll] ? C_SWAP : C_BLOCK;
 	else
-		return state > coll_el->state ? C_SWAP : C_BLOCK;
+		return ps.state[p] > ps.state[coll] ? C_SWAP : C_BLOCK;
 }
 
 
 
-void Element::calc_loads()
+Vector Element::calc_loads(int p)
 {
-	if (sim)
+	const ParticleStore& ps = sim->particles;
+	Vector forces = sim->gravity.get_force(ps.x[p], ps.y[p], ps.mass[p]);
+	if (ps.state[p] == ST_GAS)
 	{
-		forces.Zero();
-		if (state == ST_GAS)
-		{
-			Vector base_grav = Vector::ReverseY(sim->gravity.base_grav);
-			forces += sim->gravity.get_force(x, y, mass) - base_grav + base_grav * gas_gravity;
-		}
-		else
-			forces += sim->gravity.get_force(x, y, mass);
+		Vector base_grav = Vector::ReverseY(sim->gravity.base_grav);
+		forces += base_grav * sim->type_of(p).gas_gravity - base_grav;
 	}
+	return forces;
 }
 
-void Element::update_velocity(float dt)
+void Element::update_velocity(int p, float dt)
 {
 	if (sim)
 	{
-		calc_loads();
+		ParticleStore& ps = sim->particles;
 		Vector a;
-		a = forces / mass;
+		a = calc_loads(p) / ps.mass[p];
 		// our y in the grid increases downwards
 		// as opposed to the upward increase in the normal cartesian grid
 		a.ReverseY();
-		add_velocity(a * dt);
-		add_velocity(sim->air.get_force(x, y));
-	}
-}
-
-void Element::set_pos(int x, int y, bool true_pos)
-{
-	this->x = x;
-	this->y = y;
-	if (true_pos)
-	{
-		pos.x = static_cast<float> (x);
-		pos.y = static_cast<float> (y);
+		add_velocity(p, a * dt);
+		add_velocity(p, sim->air.get_force(ps.x[p], ps.y[p]));
 	}
 }
 
-void Element::powder_pile()
+void Element::powder_pile(int p)
 {
-	if (collided_elem != EL_NONE)
+	ParticleStore& ps = sim->particles;
+	int coll = ps.collided[p];
+	if (coll != PT_NONE)
 	{
-		if (speed > pile_threshold && !moved)
+		if (ps.speed[p] > type().pile_threshold && !(ps.flags[p] & PF_MOVED))
 		{
-			Vector perp(collided_elem->x - x, collided_elem->y - y);
+			Vector perp(ps.x[coll] - ps.x[p], ps.y[coll] - ps.y[p]);
 			perp.PerpendicularCW();
 			bool side = random.next_bool();
 			perp = (side ? perp : -perp);
-			Vector ce_pos = collided_elem->pos;
-			move(ce_pos + perp);
-			if (collision)
+			Vector ce_pos = ps.get_pos(coll);
+			move(p, ce_pos + perp);
+			if (ps.flags[p] & PF_COLLISION)
 			{
 				perp.Reverse();
-				move(ce_pos + perp);
+				move(p, ce_pos + perp);
 			}
 		}
 	}
 }
 
-void Element::liquid_move()
+void Element::liquid_move(int p)
 {
-	bool ground = (collided_elem == EL_NONE);
-	Vector perp = Vector((ground ? static_cast<int>(ground_coll.x) : collided_elem->x) - x,
-		(ground ? static_cast<int>(ground_coll.y) : collided_elem->y) - y).PerpendicularCW();
+	ParticleStore& ps = sim->particles;
+	int coll = ps.collided[p];
+	bool ground = (coll == PT_NONE);
+	Vector perp = Vector((ground ? ps.coll_x[p] : ps.x[coll]) - ps.x[p],
+		(ground ? ps.coll_y[p] : ps.y[coll]) - ps.y[p]).PerpendicularCW();
 	bool side = random.next_bool();
 	perp = (side ? perp : -perp);
-	move(pos + perp);
-	if (collision)
+	move(p, ps.get_pos(p) + perp);
+	if (ps.flags[p] & PF_COLLISION)
 	{
 		perp.Reverse();
-		move(pos + perp);
+		move(p, ps.get_pos(p) + perp);
 	}
 }
 
-void Element::burn()
+void Element::burn(int p)
 {
 	if (sim)
 	{
-		life -= 1 * flammability;
-		add_heat(1000 * flammability);
+		ParticleStore& ps = sim->particles;
+		float flammability = type().flammability;
+		ps.life[p] -= 1 * flammability;
+		sim->chunks.wake(ps.x[p], ps.y[p]);
+		add_heat(p, 1000 * flammability);
 		if (random.chance(static_cast<int>(flammability), 1000))
 		{
-			std::vector<int> idx;
+			int x = ps.x[p], y = ps.y[p];
+			int idx[8];
+			int count = 0;
 			for (int i = -1; i <= 1; i++)
 				for (int j = -1; j <= 1; j++)
 					if ((i || j) && sim->check_if_empty(x + j, y + i))
-						idx.push_back(IDX(x + j, y + i, sim->cells_x_count));
-			if (!idx.empty())
+						idx[count++] = IDX(x + j, y + i, sim->cells_x_count);
+			if (count > 0)
 				sim->create_element(EL_FIRE, false, false,
-					idx[random.between(0, idx.size() - 1)]);
+					idx[random.between(0, count - 1)]);
 		}
 	}
 }
 
-bool Element::ignite()
+bool Element::ignite(int p)
 {
 	bool res = false;
 	if (sim)
 	{
+		ParticleStore& ps = sim->particles;
+		int x = ps.x[p], y = ps.y[p];
 		for (int i = -1; i <= 1; i++)
 			for (int j = -1; j <= 1; j++)
 				if ((i || j) && !sim->check_if_empty(x + j, y + i) &&
 					sim->bounds_check(x + j, y + i))
 				{
-					std::shared_ptr<Element> target = sim->get_from_grid(x + j, y + i);
-					if (((target->prop & Flammable) == Flammable ||
-						(target->prop & Explosive) == Explosive) &&
-						(target->prop & Burning) != Burning &&
-						random.chance(static_cast<int>(target->flammability), 1000))
+					int target = sim->get_from_grid(x + j, y + i);
+					if (((ps.prop[target] & Flammable) == Flammable ||
+						(ps.prop[target] & Explosive) == Explosive) &&
+						(ps.prop[target] & Burning) != Burning)
 					{
-						target->prop |= Burning;
-						res = true;
+						// stays awake while there is something to ignite
+						sim->chunks.wake(x, y);
+						if (random.chance(static_cast<int>(sim->type_of(target).flammability), 1000))
+						{
+							ps.prop[target] |= Burning;
+							res = true;
+						}
 					}
 				}
 	}
 	return res;
 }
 
-bool Element::corrode(Element* el)
+bool Element::corrode(int p, int coll)
 {
 	bool res = false;
-	if (el && identifier != el->identifier
-		&& random.chance(1000 - el->endurance, 1000))
+	ParticleStore& ps = sim->particles;
+	if (coll != PT_NONE && ps.type[p] != ps.type[coll])
 	{
-		el->prop |= Destroyed;
-		life--;
-		res = true;
+		// stays awake while touching something it can corrode
+		sim->chunks.wake(ps.x[p], ps.y[p]);
+		if (random.chance(1000 - sim->type_of(coll).endurance, 1000))
+		{
+			ps.prop[coll] |= Destroyed;
+			ps.life[p]--;
+			res = true;
+		}
 	}
 	return res;
 }
 
-bool Element::extinguish(Element* coll_el)
+bool Element::extinguish(int p, int coll)
 {
 	bool res = false;
-	if (coll_el && (coll_el->prop & Burning) == Burning)
+	ParticleStore& ps = sim->particles;
+	if (coll != PT_NONE && (ps.prop[coll] & Burning) == Burning)
 	{
-		coll_el->prop &= ~Burning;
+		ps.prop[coll] &= ~Burning;
+		sim->chunks.wake(ps.x[coll], ps.y[coll]);
 	}
 	return res;
 }
 
 
-void Element::apply_collision_impulse(float dt)
+void Element::apply_collision_impulse(int p, float dt)
 {
-	bool ground = (collided_elem == EL_NONE);
-	Vector vr = (ground ? velocity : velocity - collided_elem->velocity);
-	Vector d = (ground ? pos - ground_coll : pos - collided_elem->pos);
+	ParticleStore& ps = sim->particles;
+	int coll = ps.collided[p];
+	bool ground = (coll == PT_NONE);
+	Vector velocity = ps.get_velocity(p);
+	Vector vr = (ground ? velocity : velocity - ps.get_velocity(coll));
+	Vector d = (ground ? ps.get_pos(p) - Vector(ps.coll_x[p], ps.coll_y[p])
+		: ps.get_pos(p) - ps.get_pos(coll));
 	d.Normalize();
-	float nominator = (-(1 + restitution) * (vr * d));
-	float denominator = ((d * d) * (1 / mass + (ground ? 0 : 1 / collided_elem->mass)));
+	float nominator = (-(1 + type().restitution) * (vr * d));
+	float denominator = ((d * d) * (1 / ps.mass[p] + (ground ? 0 : 1 / ps.mass[coll])));
 	//not sure if this completely fixes the bug
 	if (denominator == 0.f && nominator == 0.f)
 		return;
 	float j = nominator
 		/ denominator;
-	add_velocity(j * d / mass);
+	add_velocity(p, j * d / ps.mass[p]);
 	if (!ground)
 	{
-		collided_elem->add_velocity(-(j * d) / collided_elem->mass);
+		add_velocity(coll, -(j * d) / ps.mass[coll]);
 	}
 }
 
-void Element::add_velocity(Vector nvelocity)
+void Element::add_velocity(int p, Vector nvelocity)
 {
-	velocity += nvelocity;
-	speed = velocity.Magnitude();
+	ParticleStore& ps = sim->particles;
+	ps.vel_x[p] += nvelocity.x;
+	ps.vel_y[p] += nvelocity.y;
+	ps.speed[p] = ps.get_velocity(p).Magnitude();
 }
 
-void Element::add_heat(float heat)
+void Element::add_heat(int p, float heat)
 {
-	temperature += (heat / (mass * 1000) / specific_heat_cap);
+	ParticleStore& ps = sim->particles;
+	// p might belong to another element, e.g. a neighbour
+	// receiving heat, so the constants are taken from its type
+	float temperature = ps.temperature[p]
+		+ (heat / (ps.mass[p] * 1000) / sim->type_of(p).specific_heat_cap);
 	temperature = std::clamp(temperature, 0.0f, 10000.0f);
+	if (fabsf(temperature - ps.temperature[p]) > CHUNK_HEAT_EPS)
+		sim->chunks.wake(ps.x[p], ps.y[p]);
+	ps.temperature[p] = temperature;
 }
 
-int Element::update(float dt)
+int Element::update(int p, float dt)
 {
 	int transition = identifier;
 	if (sim)
 	{
-		if (((prop & Life_Dependant) == Life_Dependant && life < 0)
-			|| (prop & Destroyed) == Destroyed)
+		ParticleStore& ps = sim->particles;
+		const ElementType& t = type();
+		ElementProperties old_prop = ps.prop[p];
+		uint8_t old_state = ps.state[p];
+		if (((ps.prop[p] & Life_Dependant) == Life_Dependant && ps.life[p] < 0)
+			|| (ps.prop[p] & Destroyed) == Destroyed)
 		{
 			return EL_NONE_ID;
 		}
-		if ((prop & Life_Decay) == Life_Decay)
-			life--;
-		moved = false;
-		if ((prop & Meltable) == Meltable && temperature > melting_temperature)
+		if ((ps.prop[p] & Life_Decay) == Life_Decay)
+		{
+			ps.life[p]--;
+			sim->chunks.wake(ps.x[p], ps.y[p]);
+		}
+		ps.flags[p] &= ~PF_MOVED;
+		if ((ps.prop[p] & Meltable) == Meltable && ps.temperature[p] > t.melting_temperature)
 		{
-			state = ST_LIQUID;
-			prop |= Melted;
+			ps.state[p] = ST_LIQUID;
+			ps.prop[p] |= Melted;
 		}
-		if ((prop & Melted) == Melted && temperature < melting_temperature)
+		if ((ps.prop[p] & Melted) == Melted && ps.temperature[p] < t.melting_temperature)
 		{
-			state = ST_SOLID;
-			prop &= ~Melted;
+			ps.state[p] = ST_SOLID;
+			ps.prop[p] &= ~Melted;
 		}
-		if ((prop & Breakable) == Breakable
-			&& fabsf(sim->air.get_pressure(x, y)) > br_pressure)
-			state = ST_POWDER;
-		if (state != ST_SOLID)
+		if ((ps.prop[p] & Breakable) == Breakable
+			&& fabsf(sim->air.get_pressure(ps.x[p], ps.y[p])) > t.br_pressure)
+			ps.state[p] = ST_POWDER;
+		if ((old_state == ST_SOLID) != (ps.state[p] == ST_SOLID))
+			sim->air.set_solid(ps.x[p], ps.y[p], ps.state[p] == ST_SOLID);
+		if (ps.state[p] != ST_SOLID)
 		{
-			update_velocity(dt);
-			move(pos + (velocity * dt) / sim->scale);
-			if (collision)
+			update_velocity(p, dt);
+			move(p, ps.get_pos(p) + (ps.get_velocity(p) * dt) / sim->scale);
+			if (ps.flags[p] & PF_COLLISION)
 			{
-				collision_response();
-				if (collided_elem != EL_NONE)
+				sim->collision_response(p);
+				int coll = ps.collided[p];
+				if (coll != PT_NONE)
 				{
-					collided_elem->collided_elem = this;
-					collided_elem->collision_response();
+					ps.collided[coll] = p;
+					sim->collision_response(coll);
 				}
-				apply_collision_impulse(dt);
-				if (state == ST_POWDER)
+				apply_collision_impulse(p, dt);
+				if (ps.state[p] == ST_POWDER)
 				{
-					powder_pile();
+					powder_pile(p);
 				}
-				else if (state == ST_LIQUID)
+				else if (ps.state[p] == ST_LIQUID)
 				{
-					liquid_move();
+					liquid_move(p);
 				}
 			}
-			if (state == ST_GAS)
+			if (ps.state[p] == ST_GAS)
 			{
-				sim->air.add_pressure(x, y, gas_pressure);
-				if ((y + 1) / sim->air.cell_size < sim->air.grid_height)
-					sim->air.add_pressure(x, y + 1, gas_pressure);
-				if ((x + 1) / sim->air.cell_size < sim->air.grid_width)
+				Air& air = sim->air;
+				int x = ps.x[p], y = ps.y[p];
+				float gas_pressure = t.gas_pressure;
+				// the air cells of the particle and of its right and lower neighbours
+				int ax = x / air.cell_size, ay = y / air.cell_size;
+				int ax1 = (x + 1) / air.cell_size, ay1 = (y + 1) / air.cell_size;
+				bool down = ay1 < air.grid_height;
+				air.deposit_pressure(ax, ay, gas_pressure);
+				if (down)
+					air.deposit_pressure(ax, ay1, gas_pressure);
+				if (ax1 < air.grid_width)
 				{
-					sim->air.add_pressure(x + 1, y, gas_pressure);
-					if ((y + 1) / sim->air.cell_size < sim->air.grid_height)
-						sim->air.add_pressure(x + 1, y + 1, gas_pressure);
+					air.deposit_pressure(ax1, ay, gas_pressure);
+					if (down)
+						air.deposit_pressure(ax1, ay1, gas_pressure);
 				}
 				/*if ((x - 1) / safe_sim->air.cell_size >= 0)
 				{
@@ -415,152 +451,143 @@ int Element::update(float dt)
 				}*/
 			}
 		}
-		if ((prop & Burning) != Burning && (prop & Flammable) == Flammable
-			&& temperature > spontaneous_combustion_tmp)
-			prop |= Burning;
-		if ((prop & Burning) == Burning)
-			burn();
-		if ((prop & Igniter) == Igniter)
-			ignite();
-		for (int i = -1; i < 2; i++)
-		{
-			for (int j = -1; j < 2; j++)
-			{
-				if (i || j)
-				{
-					std::shared_ptr<Element> el = sim->get_from_grid(x + j, y + i);
-					if (el != EL_NONE && el->temperature < temperature)
-					{
-						float heat = thermal_cond * (temperature - el->temperature)
-							* sim->heat_coef;
-						el->add_heat(heat);
-						add_heat(-heat);
-					}
-				}
-			}
-		}
-
+		int x = ps.x[p], y = ps.y[p];
+		// the air is sampled once, it doesn't change during the tick
+		int air_x = x / sim->air.cell_size, air_y = y / sim->air.cell_size;
+		int air_idx = air_x + sim->air.grid_width * air_y;
+		float air_pressure = sim->air.pv[air_idx];
+		if ((ps.prop[p] & Burning) != Burning && (ps.prop[p] & Flammable) == Flammable
+			&& ps.temperature[p] > t.spontaneous_combustion_tmp)
+			ps.prop[p] |= Burning;
+		if ((ps.prop[p] & Burning) == Burning)
+			burn(p);
+		if ((ps.prop[p] & Igniter) == Igniter)
+			ignite(p);
+		// the heat between neighbours is conducted by sim->heat
 		if (sim->air.ambient_heat
-			&& temperature != sim->air.get_temperature(x, y))
+			&& ps.temperature[p] != sim->air.hv[air_idx])
 		{
-			bool hotter = temperature > sim->air.get_temperature(x, y);
-			float heat = (hotter ? thermal_cond : sim->air.air_tc) *
-				(fabsf(sim->air.get_temperature(x, y) - temperature))
+			float air_temperature = sim->air.hv[air_idx];
+			bool hotter = ps.temperature[p] > air_temperature;
+			float heat = (hotter ? t.thermal_cond : sim->air.air_tc) *
+				(fabsf(air_temperature - ps.temperature[p]))
 				* sim->heat_coef;
-			add_heat(heat * (hotter ? -1 : 1));
-			sim->air.add_heat(x, y, heat * (hotter ? 1 : -1));
+			add_heat(p, heat * (hotter ? -1 : 1));
+			sim->air.deposit_heat(air_x, air_y, heat * (hotter ? 1 : -1));
 		}
 		// Kinda repeating code but this is here so explosions happen faster
-		if ((prop & Explosive) == Explosive)
+		if ((ps.prop[p] & Explosive) == Explosive)
 		{
 			for (int i = -1; i < 2; i++)
 				for (int j = -1; j < 2; j++)
 					if ((i || j)
 						&& sim->check_id(x + j, y + i, EL_FIRE)
-						&& (prop & Burning) != Burning &&
-						random.chance(static_cast<int>(flammability), 1000))
-						prop |= Burning;
+						&& (ps.prop[p] & Burning) != Burning &&
+						random.chance(static_cast<int>(t.flammability), 1000))
+						ps.prop[p] |= Burning;
 		}
-		if (((prop & Explosive) == Explosive && (prop & Burning) == Burning)
-			|| ((prop & Explosive_Pressure) == Explosive_Pressure
-				&& fabsf(sim->air.get_pressure(x, y)) > 2.5f))
+		if (((ps.prop[p] & Explosive) == Explosive && (ps.prop[p] & Burning) == Burning)
+			|| ((ps.prop[p] & Explosive_Pressure) == Explosive_Pressure
+				&& fabsf(air_pressure) > 2.5f))
 		{
-			sim->air.add_pressure(x, y, 0.25);
+			sim->air.deposit_pressure(air_x, air_y, 0.25);
 			return EL_FIRE;
 		}
 
-		if (sim->air.get_pressure(x, y) < low_pressure)
-			transition = low_pressure_transition;
+		if (ps.prop[p] != old_prop || ps.state[p] != old_state)
+			sim->chunks.wake(x, y);
+
+		if (air_pressure < t.low_pressure)
+			transition = t.low_pressure_transition;
 
-		else if (sim->air.get_pressure(x, y) > high_pressure)
-			transition = high_pressure_transition;
+		else if (air_pressure > t.high_pressure)
+			transition = t.high_pressure_transition;
 
-		else if (temperature < low_temperature)
-			transition = low_temperature_transition;
+		else if (ps.temperature[p] < t.low_temperature)
+			transition = t.low_temperature_transition;
 
-		else if (temperature > high_temperature)
-			transition = high_temperature_transition;
+		else if (ps.temperature[p] > t.high_temperature)
+			transition = t.high_temperature_transition;
 	}
 	return transition;
 }
 
-void Element::draw_ui()
+void Element::draw_ui(int p, ElementEditor* editor)
 {
 	if (sim)
 	{
-		float old_mass = mass;
-		if (editor->float_prop(mass, "mass", 1.0f, 10.0f))
-		{
-			sim->gravity.update_mass(old_mass, -1, -1, x, y);
-			sim->gravity.update_mass(mass, x, y, -1, -1);
-		}
-		editor->float_prop(speed, "speed", 1.0f, 10.0f, DrawLineGraph);
-		editor->int_prop(endurance, "endurance", 1, 5);
-		editor->int_prop(pile_threshold, "piling threshold", 1, 3);
-		editor->float_prop(temperature, "temperature", 0.1f, 1.0f);
-		editor->float_prop(thermal_cond, "thermal conductivity", 0.01f, 1.0f);
-		editor->float_prop(specific_heat_cap, "specific heat capacity", 0.01f, 1.0f);
-		if (state == ST_GAS)
+		ParticleStore& ps = sim->particles;
+		ElementType& t = type();
+		// the element itself is edited through the values
+		// its particles start with
+		bool el = p == PT_NONE;
+		float& p_mass = el ? t.mass : ps.mass[p];
+		editor->float_prop(p_mass, "mass", 1.0f, 10.0f);
+		if (!el)
+			editor->float_prop(ps.speed[p], "speed", 1.0f, 10.0f, DrawLineGraph);
+		editor->float_prop(el ? t.temperature : ps.temperature[p], "temperature", 0.1f, 1.0f);
+		// shared by every particle of the element
+		editor->int_prop(t.endurance, "endurance", 1, 5);
+		editor->int_prop(t.pile_threshold, "piling threshold", 1, 3);
+		editor->float_prop(t.thermal_cond, "thermal conductivity", 0.01f, 1.0f);
+		editor->float_prop(t.specific_heat_cap, "specific heat capacity", 0.01f, 1.0f);
+		if ((el ? t.state : ps.state[p]) == ST_GAS)
 		{
-			editor->float_prop(gas_gravity, "Gas gravity", 0.01f, 0.1f);
-			editor->float_prop(gas_pressure, "Gas pressure", 0.001f, 0.1f);
+			editor->float_prop(t.gas_gravity, "Gas gravity", 0.01f, 0.1f);
+			editor->float_prop(t.gas_pressure, "Gas pressure", 0.001f, 0.1f);
 		}
 	}
 }
 
-void Element::collision_response()
+void Element::collision_response(int p)
 {
-	if (collided_elem != EL_NONE)
+	ParticleStore& ps = sim->particles;
+	int coll = ps.collided[p];
+	if (coll != PT_NONE)
 	{
-		if ((prop & Extinguisher) == Extinguisher)
-			extinguish(collided_elem);
-		if ((prop & Corrosive) == Corrosive
-			&& (collided_elem->prop & Corrosive_Res) != Corrosive_Res)
-			corrode(collided_elem);
+		if ((ps.prop[p] & Extinguisher) == Extinguisher)
+			extinguish(p, coll);
+		if ((ps.prop[p] & Corrosive) == Corrosive
+			&& (ps.prop[coll] & Corrosive_Res) != Corrosive_Res)
+			corrode(p, coll);
 	}
 }
 
-std::unique_ptr<Element> Element::clone() const
-{
-	return std::unique_ptr<Element>(this->clone_impl());
-}
-
 Element::~Element()
 {
 	if (editor)
 		editor->detach();
 }
 
-void Element::render(float cell_height, float cell_width, sf::Vertex* quad)
+void Element::render(int p, float cell_height, float cell_width, sf::Vertex* quad)
 {
 	if (sim)
 	{
-		sf::Color draw_color = color;
-		if ((prop & Red_Glow) == Red_Glow)
+		const ParticleStore& ps = sim->particles;
+		const ElementType& t = type();
+		sf::Color draw_color = t.colors[ps.color[p]];
+		float temperature = ps.temperature[p];
+		if ((ps.prop[p] & Red_Glow) == Red_Glow)
 		{
-
-			std::shared_ptr<Element> org = sim->find_by_id(identifier);
-			if (org != EL_NONE)
+			float high_temp = 1100;
+			if (t.high_temperature_transition != EL_NONE_ID)
+				high_temp = t.high_temperature;
+			else if ((t.prop & Meltable) == Meltable)
+				high_temp = t.melting_temperature;
+			if (temperature > (high_temp - 800.0f))
 			{
-				float high_temp = 1100;
-				if (org->high_temperature_transition != EL_NONE_ID)
-					high_temp = org->high_temperature;
-				else if ((org->prop & Meltable) == Meltable)
-					high_temp = org->melting_temperature;
-				if (org && temperature > (high_temp - 800.0f))
-				{
-					int r = draw_color.r, g = draw_color.g, b = draw_color.b;
-					float gradv = 3.1415f / (2 * high_temp - (high_temp - 800.0f));
-					float caddress = (temperature > high_temp) ? high_temp - (high_temp - 800.0f) : temperature - (high_temp - 800.0f);
-					r += static_cast<int>(sin(gradv * caddress) * 226);
-					g += static_cast<int>(sin(gradv * caddress * 4.55 + 3.14) * 34);
-					b += static_cast<int>(sin(gradv * caddress * 2.22 + 3.14) * 64);
-					draw_color.r = std::clamp(r, 0, 255);
-					draw_color.g = std::clamp(g, 0, 255);
-					draw_color.b = std::clamp(b, 0, 255);
-				}
+				int r = draw_color.r, g = draw_color.g, b = draw_color.b;
+				float gradv = 3.1415f / (2 * high_temp - (high_temp - 800.0f));
+				float caddress = (temperature > high_temp) ? high_temp - (high_temp - 800.0f) : temperature - (high_temp - 800.0f);
+				r += static_cast<int>(sin(gradv * caddress) * 226);
+				g += static_cast<int>(sin(gradv * caddress * 4.55 + 3.14) * 34);
+				b += static_cast<int>(sin(gradv * caddress * 2.22 + 3.14) * 64);
+				draw_color.r = std::clamp(r, 0, 255);
+				draw_color.g = std::clamp(g, 0, 255);
+				draw_color.b = std::clamp(b, 0, 255);
 			}
 		}
+		int x = ps.x[p], y = ps.y[p];
 		for (int i = 0; i < 4; i++)
 		{
 			quad[i].position = sf::Vector2f((x + ((i == 1 || i == 2) ? 1 : 0)) * cell_width,
@@ -568,4 +595,4 @@ void Element::render(float cell_height, float cell_width, sf::Vertex* quad)
 			quad[i].color = draw_color;
 		}
 	}
-}
\ No newline at end of file
+}
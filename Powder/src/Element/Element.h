@@ -2,153 +2,56 @@
 #include <string>
 #include <SFML/Graphics.hpp>
 #include "ElementsIds.h"
+#include "ElementType.h"
 #include "UI/ElementEditor.h"
 #include "Utils/Vector.h"
 #include "SimObject.h"
 
-enum ElementProperties : uint16_t
-{
-	NoProperties = 0,
-	Meltable = 1 << 0,
-	Melted = 1 << 1,
-	// if no high_temperature_transition is set
-	// will use high_temperature for spontaneous combustion
-	Flammable = 1 << 2,
-	Red_Glow = 1 << 3,
-	Explosive = 1 << 4,
-	Explosive_Pressure = 1 << 5,
-	Corrosive = 1 << 6,
-	Corrosive_Res = 1 << 7,
-	Life_Dependant = 1 << 8,
-	Life_Decay = 1 << 9,
-	Burning = 1 << 10,
-	Igniter = 1 << 11,
-	Breakable = 1 << 12,
-	Extinguisher = 1 << 13,
-	Destroyed = 1 << 15
-};
-
-constexpr ElementProperties operator& (ElementProperties x, ElementProperties y)
-{
-	return static_cast<ElementProperties>(
-		static_cast<uint16_t>(x) & static_cast<uint16_t>(y));
-}
-
-constexpr ElementProperties operator| (ElementProperties x, ElementProperties y)
-{
-	return static_cast<ElementProperties>(
-		static_cast<uint16_t>(x) | static_cast<uint16_t>(y));
-}
-
-constexpr ElementProperties operator^ (ElementProperties x, ElementProperties y)
-{
-	return static_cast<ElementProperties>(
-		static_cast<uint16_t>(x) ^ static_cast<uint16_t>(y));
-}
-
-constexpr ElementProperties operator~ (ElementProperties x)
-{
-	return static_cast<ElementProperties>(~static_cast<uint16_t>(x));
-}
-
-constexpr ElementProperties& operator&= (ElementProperties& x, ElementProperties y)
-{
-	x = x & y; return x;
-}
-
-constexpr ElementProperties& operator|= (ElementProperties& x, ElementProperties y)
-{
-	x = x | y; return x;
-}
-
-constexpr ElementProperties& operator^= (ElementProperties& x, ElementProperties y)
-{
-	x = x ^ y; return x;
-}
-
-
 class Simulation;
 
+// Describes the behaviour of an element.
+// Only one instance exists per element, the state of every
+// particle lives in the Simulation's ParticleStore
+// and is accessed through the particle index p.
 class Element :
 	public SimObject
 {
 public:
-	Simulation* sim = nullptr; // pointer to the Simulation the element currently is 
-	ElementEditor* editor = nullptr;
-	int x = 0; // Current position in the grid of elements
-	int y = 0; //
-	Vector pos = Vector(0, 0);
-	Vector velocity;
-	float speed = 0.0f;
-	bool moved = false;
-	Vector forces;
-	// how much gravity affects gases
-	// set to negative to make the effect of rising up
-	float gas_gravity = 1.f;
-	float gas_pressure = 0;
-	float mass = 1;
-	int endurance = 10;
-	float life = 100.f;
-	float restitution = 0.6f;
-	float temperature = 0; //in kelvins
-	float thermal_cond = 0;
-	float specific_heat_cap = 0;
-	float flammability = 1.f;
-	int previous_id = EL_NONE_ID;
-	int state = 0; // 0 - gas 1 - liquid 2 - powder 3 - solid  
-	ElementProperties prop = NoProperties;
-	void element_copy(const Element& rhs);
-	// Moves the element across a line (the start of the line is the 
-	// x and y of the element itself and the end is xDestination and yDestination)
+	Simulation* sim = nullptr; // pointer to the Simulation the element belongs to
+	ElementEditor* editor = nullptr; // editor attached to the element itself
+	// The constants of the element inside the Simulation's type table
+	ElementType& type() const;
+	// Fills the state of the newly created particle p
+	// with the values of the element
+	virtual void init_particle(int p);
+	// Moves the particle across a line (the start of the line is the 
+	// x and y of the particle itself and the end is dest)
 	// this function uses a modified version of bresenhams line algorithm
-	// return true if there is no collision 
-	void move(Vector dest);
-	void update_velocity(float dt);
-	void set_pos(int x, int y, bool true_pos = false);
-	void apply_collision_impulse(float dt);
-	void add_velocity(Vector nvelocity);
-	void add_heat(float heat);
-	virtual int update(float dt);
-	virtual void render(float cell_height, float cell_width, sf::Vertex* quad);
-	virtual void draw_ui();
-	virtual void collision_response();
-	std::unique_ptr<Element> clone() const;
+	void move(int p, Vector dest);
+	void update_velocity(int p, float dt);
+	void apply_collision_impulse(int p, float dt);
+	void add_velocity(int p, Vector nvelocity);
+	void add_heat(int p, float heat);
+	virtual int update(int p, float dt);
+	virtual void render(int p, float cell_height, float cell_width, sf::Vertex* quad);
+	// Draws the properties of the particle p,
+	// if p is PT_NONE the properties of the element itself are drawn
+	virtual void draw_ui(int p, ElementEditor* editor);
+	virtual void collision_response(int p);
 	virtual ~Element();
 protected:
-	int low_pressure_transition = EL_NONE_ID;		// To which element the current element
-	int high_pressure_transition = EL_NONE_ID;		// will transfrom, based on the current
-	int low_temperature_transition = EL_NONE_ID;	// physical state of the element
-	int high_temperature_transition = EL_NONE_ID;	//
-	float low_pressure = -300.f;                  // Number values at which the 
-	float high_pressure = 300.f;					// transformation will occur
-	float low_temperature = -1.f;
-	float high_temperature = 10'000.f;
-	float spontaneous_combustion_tmp = 10'000.f;
-	float melting_temperature = 10'000.f;
-	float br_pressure = 300.f;
-	// used by powders in the creation of piles
-	// higher values means its harder for pile creation to occur
-	// essentially used as velocity threshold
-	// at which pile creation will happen
-	int pile_threshold = 1;
-	// damage threshold
-	Vector ground_coll;
-	Element* collided_elem = EL_NONE;
-	std::vector<sf::Color> colors;	// All the possible colors
 	// 0 - block; the element is blocked from moving further
 	// 1 - pass; both elements occupy the same space
 	// 2 - swap; the elements switch places
-	virtual int eval_col(Element* el);
-	void calc_loads();
-	bool collision = false;
-	void burn();
-	bool ignite();
-	bool extinguish(Element* el);
-	bool corrode(Element* el);
-	void liquid_move();
-	void powder_pile();
-	virtual Element* clone_impl() const = 0;
+	virtual int eval_col(int p, int coll);
+	Vector calc_loads(int p);
+	void burn(int p);
+	bool ignite(int p);
+	bool extinguish(int p, int coll);
+	bool corrode(int p, int coll);
+	void liquid_move(int p);
+	void powder_pile(int p);
 private:
-	void move_helper(int xO, int yO, int d, int xStep, int yStep, int de, int dr, bool ytype);
-	void do_move(int diff_x, int diff_y);
+	void move_helper(int p, int xO, int yO, int d, int xStep, int yStep, int de, int dr, bool ytype);
+	void do_move(int p, int diff_x, int diff_y);
 };
\ No newline at end of file
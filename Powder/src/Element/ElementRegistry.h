@@ -0,0 +1,81 @@
+#pragma once
+#include <memory>
+#include <type_traits>
+#include "ElementIncludes.h"
+
+// Generated from the Elements folder, every element found there
+// is registered and dispatched through the functions below
+
+// Calls f with the element cast to the class of the identifier.
+// The element classes are final so the calls made through
+// the cast pointer are resolved at compile time
+template <typename F>
+static inline auto element_visit(int id, Element* el, F&& f)
+{
+	switch (id)
+	{
+	case EL_ACID: return f(static_cast<Acid*>(el));
+	case EL_BHOL: return f(static_cast<BHOL*>(el));
+	case EL_BRICK: return f(static_cast<Brick*>(el));
+	case EL_CAUS: return f(static_cast<Caus*>(el));
+	case EL_COAL: return f(static_cast<Coal*>(el));
+	case EL_DUST: return f(static_cast<Dust*>(el));
+	case EL_EXC4: return f(static_cast<EXC4*>(el));
+	case EL_FIRE: return f(static_cast<Fire*>(el));
+	case EL_GAS: return f(static_cast<Gas*>(el));
+	case EL_GOL: return f(static_cast<GOL*>(el));
+	case EL_GOLD: return f(static_cast<Gold*>(el));
+	case EL_GUN: return f(static_cast<Gun*>(el));
+	case EL_ICE: return f(static_cast<Ice*>(el));
+	case EL_LAVA: return f(static_cast<Lava*>(el));
+	case EL_METL: return f(static_cast<Metl*>(el));
+	case EL_NITR: return f(static_cast<Nitr*>(el));
+	case EL_OIL: return f(static_cast<Oil*>(el));
+	case EL_SAND: return f(static_cast<Sand*>(el));
+	case EL_STONE: return f(static_cast<Stone*>(el));
+	case EL_WALL: return f(static_cast<WALL*>(el));
+	case EL_WATER: return f(static_cast<Water*>(el));
+	case EL_WHOL: return f(static_cast<WHOL*>(el));
+	case EL_WOOD: return f(static_cast<Wood*>(el));
+	case EL_WTRV: return f(static_cast<Wtrv*>(el));
+	default: return f(el);
+	}
+}
+
+template <typename T, typename S>
+static inline void register_element(S& sim)
+{
+	// base classes like GOL can't be spawned
+	if constexpr (!std::is_abstract_v<T>)
+		sim.add_element(std::make_shared<T>(sim));
+}
+
+// Adds every element to the simulation
+template <typename S>
+static inline void register_elements(S& sim)
+{
+	register_element<Acid>(sim);
+	register_element<BHOL>(sim);
+	register_element<Brick>(sim);
+	register_element<Caus>(sim);
+	register_element<Coal>(sim);
+	register_element<Dust>(sim);
+	register_element<EXC4>(sim);
+	register_element<Fire>(sim);
+	register_element<Gas>(sim);
+	register_element<GOL>(sim);
+	register_element<Gold>(sim);
+	register_element<Gun>(sim);
+	register_element<Ice>(sim);
+	register_element<Lava>(sim);
+	register_element<Metl>(sim);
+	register_element<Nitr>(sim);
+	register_element<Oil>(sim);
+	register_element<Sand>(sim);
+	register_element<Stone>(sim);
+	register_element<WALL>(sim);
+	register_element<Water>(sim);
+	register_element<WHOL>(sim);
+	register_element<Wood>(sim);
+	register_element<Wtrv>(sim);
+}
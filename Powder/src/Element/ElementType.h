@@ -0,0 +1,105 @@
+#pragma once
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include "ElementsIds.h"
+
+enum ElementProperties : uint16_t
+{
+	NoProperties = 0,
+	Meltable = 1 << 0,
+	Melted = 1 << 1,
+	// if no high_temperature_transition is set
+	// will use high_temperature for spontaneous combustion
+	Flammable = 1 << 2,
+	Red_Glow = 1 << 3,
+	Explosive = 1 << 4,
+	Explosive_Pressure = 1 << 5,
+	Corrosive = 1 << 6,
+	Corrosive_Res = 1 << 7,
+	Life_Dependant = 1 << 8,
+	Life_Decay = 1 << 9,
+	Burning = 1 << 10,
+	Igniter = 1 << 11,
+	Breakable = 1 << 12,
+	Extinguisher = 1 << 13,
+	Destroyed = 1 << 15
+};
+
+constexpr ElementProperties operator& (ElementProperties x, ElementProperties y)
+{
+	return static_cast<ElementProperties>(
+		static_cast<uint16_t>(x) & static_cast<uint16_t>(y));
+}
+
+constexpr ElementProperties operator| (ElementProperties x, ElementProperties y)
+{
+	return static_cast<ElementProperties>(
+		static_cast<uint16_t>(x) | static_cast<uint16_t>(y));
+}
+
+constexpr ElementProperties operator^ (ElementProperties x, ElementProperties y)
+{
+	return static_cast<ElementProperties>(
+		static_cast<uint16_t>(x) ^ static_cast<uint16_t>(y));
+}
+
+constexpr ElementProperties operator~ (ElementProperties x)
+{
+	return static_cast<ElementProperties>(~static_cast<uint16_t>(x));
+}
+
+constexpr ElementProperties& operator&= (ElementProperties& x, ElementProperties y)
+{
+	x = x & y; return x;
+}
+
+constexpr ElementProperties& operator|= (ElementProperties& x, ElementProperties y)
+{
+	x = x | y; return x;
+}
+
+constexpr ElementProperties& operator^= (ElementProperties& x, ElementProperties y)
+{
+	x = x ^ y; return x;
+}
+
+// The constants of an element, shared by every particle of the element.
+// The Simulation keeps one per element in a table indexed by the identifier,
+// the particles themselves only store the state that changes.
+struct ElementType
+{
+	// The values every new particle of the element starts with
+	float mass = 1;
+	float life = 100.f;
+	float temperature = 0; //in kelvins
+	int state = 0; // 0 - gas 1 - liquid 2 - powder 3 - solid  
+	ElementProperties prop = NoProperties;
+	// how much gravity affects gases
+	// set to negative to make the effect of rising up
+	float gas_gravity = 1.f;
+	float gas_pressure = 0;
+	int endurance = 10;
+	float restitution = 0.6f;
+	float thermal_cond = 0;
+	float specific_heat_cap = 0;
+	float flammability = 1.f;
+	int low_pressure_transition = EL_NONE_ID;		// To which element the current element
+	int high_pressure_transition = EL_NONE_ID;		// will transfrom, based on the current
+	int low_temperature_transition = EL_NONE_ID;	// physical state of the element
+	int high_temperature_transition = EL_NONE_ID;	//
+	float low_pressure = -300.f;                  // Number values at which the 
+	float high_pressure = 300.f;					// transformation will occur
+	float low_temperature = -1.f;
+	float high_temperature = 10'000.f;
+	float spontaneous_combustion_tmp = 10'000.f;
+	float melting_temperature = 10'000.f;
+	float br_pressure = 300.f;
+	// used by powders in the creation of piles
+	// higher values means its harder for pile creation to occur
+	// essentially used as velocity threshold
+	// at which pile creation will happen
+	int pile_threshold = 1;
+	// Set for the elements derived from GOL, which are run by the LifeEngine
+	bool gol = false;
+	std::vector<sf::Color> colors;	// All the possible colors
+};
@@ -1,13 +1,10 @@
 #pragma once
 #include "Element/Element.h"
-class Acid :
+class Acid final :
 	public Element
 {
 public:
 	Acid(Simulation& sim);
-	Acid(const Acid& rhs);
 	~Acid();
-protected:
-	Element* clone_impl() const override;
 };
 
@@ -2,28 +2,23 @@
 #include "Simulation.h"
 #include "Utils/Random.h"
 
-Element* BHOL::clone_impl() const
+int BHOL::update(int p, float dt)
 {
-	return new BHOL(*this);
-}
-
-int BHOL::update(float dt)
-{
-	if (mass < sim->gravity.mass_th)
-	{
-		sim->gravity.update_mass(mass, -1, -1, x, y);
-		mass = sim->gravity.mass_th;
-		sim->gravity.update_mass(mass, x, y, -1, -1);
-	}
+	ParticleStore& ps = sim->particles;
+	if (ps.mass[p] < sim->gravity.mass_th)
+		ps.mass[p] = sim->gravity.mass_th;
 	return identifier;
 }
 
-void BHOL::collision_response()
+void BHOL::collision_response(int p)
 {
-	if (collided_elem != EL_NONE)
+	ParticleStore& ps = sim->particles;
+	int coll = ps.collided[p];
+	if (coll != PT_NONE)
 	{
-		collided_elem->prop |= Destroyed;
-		mass += collided_elem->mass;
+		ps.prop[coll] |= Destroyed;
+		ps.mass[p] += ps.mass[coll];
+		sim->chunks.wake(ps.x[coll], ps.y[coll]);
 	}
 }
 
@@ -32,24 +27,19 @@ BHOL::BHOL(Simulation& sim)
 	identifier = EL_BHOL;
 	name = "BHOL";
 	description = "Mass always equal to the mass threshold of the gravity.Needs newtonian gravity to work";
-	colors = { sf::Color(44, 44, 44) };
-	color = colors[0];
-	mass = sim.gravity.mass_th;
-	restitution = 0.f;
-	temperature = 295.15f;
-	thermal_cond = 1.f;
-	specific_heat_cap = 1.f;
-	endurance = 1000;
-	state = ST_SOLID;
+	ElementType& t = sim.element_types[identifier];
+	t.colors = { sf::Color(44, 44, 44) };
+	color = t.colors[0];
+	t.mass = sim.gravity.mass_th;
+	t.restitution = 0.f;
+	t.temperature = 295.15f;
+	t.thermal_cond = 1.f;
+	t.specific_heat_cap = 1.f;
+	t.endurance = 1000;
+	t.state = ST_SOLID;
 	this->sim = &sim;
 }
 
-BHOL::BHOL(const BHOL& rhs)
-{
-	Element::element_copy(rhs);
-}
-
-
 BHOL::~BHOL()
 {
 }
@@ -1,14 +1,11 @@
 #pragma once
 #include "Element/Element.h"
-class BHOL :
+class BHOL final :
 	public Element
 {
 public:
-	int update(float dt) override;
-	void collision_response() override;
+	int update(int p, float dt) override;
+	void collision_response(int p) override;
 	BHOL(Simulation& sim);
-	BHOL(const BHOL& rhs);
 	~BHOL();
-protected:
-	Element * clone_impl() const override;
 };
@@ -1,12 +1,9 @@
 #pragma once
 #include "Element/Element.h"
-class Brick :
+class Brick final :
 	public Element
 {
 public:
 	Brick(Simulation& sim);
-	Brick(const Brick& rhs);
 	~Brick();
-protected:
-	Element * clone_impl() const override;
 };
\ No newline at end of file
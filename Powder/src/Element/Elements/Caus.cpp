@@ -2,9 +2,10 @@
 #include "Utils\Random.h"
 #include "Simulation.h"
 
-Element* Caus::clone_impl() const
+void Caus::init_particle(int p)
 {
-	return new Caus(*this);
+	Element::init_particle(p);
+	sim->particles.life[p] = static_cast<float>(random.between(100, 140));
 }
 
 Caus::Caus(Simulation& sim)
@@ -12,28 +13,22 @@ Caus::Caus(Simulation& sim)
 	identifier = EL_CAUS;
 	name = "Caustic";
 	description = "Caus";
-	colors = { sf::Color(127, 254, 159) };
-	color = colors[0];
-	mass = 1.f;
-	life = 23;
-	gas_gravity = 0.f;
-	gas_pressure = 0.001f;
-	restitution = 1.f;
-	temperature = 293.15f;
-	thermal_cond = 0.05f;
-	specific_heat_cap = 1.54f;
-	state = ST_GAS;
-	prop = Corrosive | Igniter | Life_Dependant;
+	ElementType& t = sim.element_types[identifier];
+	t.colors = { sf::Color(127, 254, 159) };
+	color = t.colors[0];
+	t.mass = 1.f;
+	t.life = 23;
+	t.gas_gravity = 0.f;
+	t.gas_pressure = 0.001f;
+	t.restitution = 1.f;
+	t.temperature = 293.15f;
+	t.thermal_cond = 0.05f;
+	t.specific_heat_cap = 1.54f;
+	t.state = ST_GAS;
+	t.prop = Corrosive | Igniter | Life_Dependant;
 	this->sim = &sim;
 }
 
-Caus::Caus(const Caus& rhs)
-{
-	Element::element_copy(rhs);
-	life = static_cast<float>(random.between(100, 140));
-}
-
-
 Caus::~Caus()
 {
 }
@@ -1,13 +1,11 @@
 #pragma once
 #include "Element/Element.h"
-class Caus :
+class Caus final :
 	public Element
 {
 public:
+	void init_particle(int p) override;
 	Caus(Simulation& sim);
-	Caus(const Caus& rhs);
 	~Caus();
-protected:
-	Element * clone_impl() const override;
 };
 
@@ -2,38 +2,28 @@
 #include "Simulation.h"
 #include "Utils/Random.h"
 
-Element* Coal::clone_impl() const
-{
-	return new Coal(*this);
-}
-
 Coal::Coal(Simulation& sim)
 {
 	identifier = EL_COAL;
 	name = "Coal";
 	description = "Coal";
-	colors = { sf::Color(33, 33, 33) };
-	color = colors[0];
-	mass = 5;
-	restitution = 0.f;
-	temperature = 295.15f;
-	thermal_cond = 1.17f;
-	specific_heat_cap = 2.f;
-	endurance = 970;
-	state = ST_SOLID;
-	prop = Flammable | Life_Dependant | Red_Glow;
-	flammability = 20.f;
-	spontaneous_combustion_tmp = 422.04f;
-	life = 6000.f;
+	ElementType& t = sim.element_types[identifier];
+	t.colors = { sf::Color(33, 33, 33) };
+	color = t.colors[0];
+	t.mass = 5;
+	t.restitution = 0.f;
+	t.temperature = 295.15f;
+	t.thermal_cond = 1.17f;
+	t.specific_heat_cap = 2.f;
+	t.endurance = 970;
+	t.state = ST_SOLID;
+	t.prop = Flammable | Life_Dependant | Red_Glow;
+	t.flammability = 20.f;
+	t.spontaneous_combustion_tmp = 422.04f;
+	t.life = 6000.f;
 	this->sim = &sim;
 }
 
-Coal::Coal(const Coal& rhs)
-{
-	Element::element_copy(rhs);
-}
-
-
 Coal::~Coal()
 {
 }
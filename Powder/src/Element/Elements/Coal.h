@@ -1,12 +1,9 @@
 #pragma once
 #include "Element/Element.h"
-class Coal :
+class Coal final :
 	public Element
 {
 public:
 	Coal(Simulation& sim);
-	Coal(const Coal& rhs);
 	~Coal();
-protected:
-	Element * clone_impl() const override;
 };
\ No newline at end of file
@@ -2,39 +2,29 @@
 #include "Simulation.h"
 #include "Utils/Random.h"
 
-Element* Dust::clone_impl() const
-{
-	return new Dust(*this);
-}
-
 Dust::Dust(Simulation& sim)
 {
 	identifier = EL_DUST;
 	name = "SawDust";
 	description = "Sawdust wood w";
-	colors = { sf::Color(254, 223, 159) };
-	color = colors[0];
-	mass = 1;
-	restitution = 0.f;
-	pile_threshold = 0;
-	temperature = 295.15f;
-	thermal_cond = 1.08f;
-	specific_heat_cap = 0.9f;
-	endurance = 30;
-	state = ST_POWDER;
-	prop = Flammable | Life_Dependant;
-	flammability = 40;
-	life = 2000.f;
-	spontaneous_combustion_tmp = 573.15f;
+	ElementType& t = sim.element_types[identifier];
+	t.colors = { sf::Color(254, 223, 159) };
+	color = t.colors[0];
+	t.mass = 1;
+	t.restitution = 0.f;
+	t.pile_threshold = 0;
+	t.temperature = 295.15f;
+	t.thermal_cond = 1.08f;
+	t.specific_heat_cap = 0.9f;
+	t.endurance = 30;
+	t.state = ST_POWDER;
+	t.prop = Flammable | Life_Dependant;
+	t.flammability = 40;
+	t.life = 2000.f;
+	t.spontaneous_combustion_tmp = 573.15f;
 	this->sim = &sim;
 }
 
-Dust::Dust(const Dust& rhs)
-{
-	Element::element_copy(rhs);
-}
-
-
 Dust::~Dust()
 {
 }
@@ -1,12 +1,9 @@
 #pragma once
 #include "Element/Element.h"
-class Dust :
+class Dust final :
 	public Element
 {
 public:
 	Dust(Simulation& sim);
-	Dust(const Dust& rhs);
 	~Dust();
-protected:
-	Element * clone_impl() const override;
 };
\ No newline at end of file
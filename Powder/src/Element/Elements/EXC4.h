@@ -1,12 +1,9 @@
 #pragma once
 #include "Element/Element.h"
-class EXC4 :
+class EXC4 final :
 	public Element
 {
 public:
 	EXC4(Simulation& sim);
-	EXC4(const EXC4& rhs);
 	~EXC4();
-protected:
-	Element * clone_impl() const override;
 };
\ No newline at end of file
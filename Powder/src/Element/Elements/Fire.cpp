@@ -2,9 +2,10 @@
 #include "Utils\Random.h"
 #include "Simulation.h"
 
-Element* Fire::clone_impl() const
+void Fire::init_particle(int p)
 {
-	return new Fire(*this);
+	Element::init_particle(p);
+	sim->particles.life[p] = static_cast<float>(random.between(100, 140));
 }
 
 Fire::Fire(Simulation& sim)
@@ -12,27 +13,21 @@ Fire::Fire(Simulation& sim)
 	identifier = EL_FIRE;
 	name = "Fire";
 	description = "Fire";
-	colors = {sf::Color(255, 55, 0)};
-	color = colors[0];
-	mass = 1.f;
-	gas_gravity = -1.f;
-	gas_pressure = 0.001f;
-	restitution = 0.f;
-	temperature = 695.15f;
-	thermal_cond = 5;
-	specific_heat_cap = 1.f;
-	prop = Life_Decay | Life_Dependant | Igniter;
-	state = ST_GAS;
+	ElementType& t = sim.element_types[identifier];
+	t.colors = {sf::Color(255, 55, 0)};
+	color = t.colors[0];
+	t.mass = 1.f;
+	t.gas_gravity = -1.f;
+	t.gas_pressure = 0.001f;
+	t.restitution = 0.f;
+	t.temperature = 695.15f;
+	t.thermal_cond = 5;
+	t.specific_heat_cap = 1.f;
+	t.prop = Life_Decay | Life_Dependant | Igniter;
+	t.state = ST_GAS;
 	this->sim = &sim;
 }
 
-Fire::Fire(const Fire& rhs)
-{
-	Element::element_copy(rhs);
-	life = static_cast<float>(random.between(100, 140));
-}
-
-
 Fire::~Fire()
 {
 }
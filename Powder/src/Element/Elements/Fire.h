@@ -1,12 +1,10 @@
 #pragma once
 #include "Element/Element.h"
-class Fire :
+class Fire final :
 	public Element
 {
 public:
+	void init_particle(int p) override;
 	Fire(Simulation& sim);
-	Fire(const Fire& rhs);
 	~Fire();
-protected:
-	Element * clone_impl() const override;
 };
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "GOL.h"
 #include "Simulation.h"
+#include <algorithm>
 
 void GOL::process_rules()
 {
@@ -10,6 +11,7 @@ void GOL::process_rules()
 			vl = false;
 		}
 	}
+	decay = 0;
 	if (rule_string != "")
 	{
 		unsigned type = B;
@@ -23,62 +25,53 @@ void GOL::process_rules()
 			{
 				type = S;
 			}
+			else if (c == 'D' || c == 'd')
+			{
+				type = D;
+			}
 			else if (c == '\\' || c == '/')
 			{
 				++type %= 3;
 			}
-			else if (c >= '0' || c < '9')
+			else if (c >= '0' && c <= '9')
 			{
 				if (type == D)
 				{
-					if (c - '0' == 0)
-					{
-						continue;
-					}
-					rules[type][c - '0' - 1] = true;
+					// the digits form a single number
+					decay = std::min(decay * 10 + c - '0', GOL_MAX_DECAY);
 				}
-				else
+				else if (c != '9')
 				{
 					rules[type][c - '0'] = true;
 				}
 			}
 		}
 	}
+	birth_mask = 0;
+	survive_mask = 0;
+	for (int n = 0; n < 9; n++)
+	{
+		if (rules[B][n])
+			birth_mask |= 1 << n;
+		if (rules[S][n])
+			survive_mask |= 1 << n;
+	}
 }
 
-int GOL::update(float dt) 
+int GOL::update(int p, float dt) 
 {
-	if (state == 0)
-		return EL_NONE_ID;
-	for(int i = y - 1; i < y + 2; i++)
-	{
-		for (int j = x - 1; j < x + 2; j++)
-		{
-			if (i - y || j - x) 
-			{
-				if (sim->get_from_gol(j, i) == 0)
-				{
-					int size = sim->get_gol_neigh_count(j, i);
-					sim->set_gol_at(j, i, 2);
-					if (rules[B][size])
-					{
-						sim->create_element(identifier, false, false, j, i);
-					}
-				}
-			}
-		}
-
-	}
-	if (!rules[S][sim->get_gol_neigh_count(x, y)])
-	{
+	// births and deaths are decided for the whole
+	// grid at once by the LifeEngine of the simulation
+	const ParticleStore& ps = sim->particles;
+	if (ps.state[p] == 0)
 		return EL_NONE_ID;
-	}
 	return identifier;
 }
 
-void GOL::draw_ui()
+void GOL::draw_ui(int p, ElementEditor* editor)
 {
-	Element::draw_ui();
+	Element::draw_ui(p, editor);
+	// the rules are shared by every particle of the element
 	if (editor->string_prop(rule_string, "GOL Rule"))
 		process_rules();
 }
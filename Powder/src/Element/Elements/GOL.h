@@ -1,5 +1,9 @@
 #pragma once
 #include "Element/Element.h"
+
+// Longest a cell can linger after failing to survive
+#define GOL_MAX_DECAY 255
+
 class GOL :
 	public Element
 {
@@ -18,12 +22,20 @@ public:
 	// it instead lingers in a state that is not considered alive or dead for N generations
 	// where n is the amount specified 
 	std::string rule_string = "";
+	// Only B and S are filled, D is kept in decay
 	bool rules[3][9] = { false };
 	enum { B = 0, S = 1, D = 2 };
+	// Bit n is set if a cell with n alive neighbours
+	// is born or survives, used by the LifeEngine
+	uint16_t birth_mask = 0;
+	uint16_t survive_mask = 0;
+	// Generations a cell lingers after failing to survive,
+	// taken from the D part of the rule
+	int decay = 0;
 	// Processes the rule string and fills the rules array
 	void process_rules();
-	int update(float dt) override;
-	virtual void draw_ui() override;
+	int update(int p, float dt) override;
+	virtual void draw_ui(int p, ElementEditor* editor) override;
 	virtual ~GOL() = 0;
 };
 
@@ -1,12 +1,9 @@
 #pragma once
 #include "Element/Element.h"
-class Gas :
+class Gas final :
 	public Element
 {
 public:
 	Gas(Simulation& sim);
-	Gas(const Gas& rhs);
 	~Gas();
-protected:
-	Element * clone_impl() const override;
 };
\ No newline at end of file
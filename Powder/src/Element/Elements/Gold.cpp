@@ -2,36 +2,26 @@
 #include "Simulation.h"
 #include "Utils/Random.h"
 
-Element* Gold::clone_impl() const
-{
-	return new Gold(*this);
-}
-
 Gold::Gold(Simulation& sim)
 {
 	identifier = EL_GOLD;
 	name = "Gold";
 	description = "Gold";
-	colors = { sf::Color(219, 172, 43) };
-	color = colors[0];
-	mass = 10;
-	restitution = 0.f;
-	temperature = 295.15f;
-	thermal_cond = 314.f;
-	specific_heat_cap = 0.13f;
-	endurance = 1000;
-	state = ST_SOLID;
-	melting_temperature = 1337.15f;
-	prop = Corrosive_Res | Meltable | Red_Glow;
+	ElementType& t = sim.element_types[identifier];
+	t.colors = { sf::Color(219, 172, 43) };
+	color = t.colors[0];
+	t.mass = 10;
+	t.restitution = 0.f;
+	t.temperature = 295.15f;
+	t.thermal_cond = 314.f;
+	t.specific_heat_cap = 0.13f;
+	t.endurance = 1000;
+	t.state = ST_SOLID;
+	t.melting_temperature = 1337.15f;
+	t.prop = Corrosive_Res | Meltable | Red_Glow;
 	this->sim = &sim;
 }
 
-Gold::Gold(const Gold& rhs)
-{
-	Element::element_copy(rhs);
-}
-
-
 Gold::~Gold()
 {
 }
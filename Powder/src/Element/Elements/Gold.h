@@ -1,12 +1,9 @@
 #pragma once
 #include "Element/Element.h"
-class Gold :
+class Gold final :
 	public Element
 {
 public:
 	Gold(Simulation& sim);
-	Gold(const Gold& rhs);
 	~Gold();
-protected:
-	Element * clone_impl() const override;
 };
\ No newline at end of file
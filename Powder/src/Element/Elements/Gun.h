@@ -1,12 +1,9 @@
 #pragma once
 #include "Element/Element.h"
-class Gun :
+class Gun final :
 	public Element
 {
 public:
 	Gun(Simulation& sim);
-	Gun(const Gun& rhs);
 	~Gun();
-protected:
-	Element * clone_impl() const override;
 };
\ No newline at end of file
@@ -2,37 +2,26 @@
 #include "Simulation.h"
 #include "Utils/Random.h"
 
-Element* Ice::clone_impl() const
-{
-	return new Ice(*this);
-}
-
 Ice::Ice(Simulation& sim)
 {
 	identifier = EL_ICE;
 	name = "Ice";
 	description = "Ice Ice baby";
-	colors = { sf::Color(159, 191, 254) };
-	color = colors[0];
-	mass = 1;
-	restitution = 0.1f;
-	pile_threshold = 0;
-	temperature = 245.15f;
-	thermal_cond = 2.18f;
-	specific_heat_cap = 0.50f;
-	state = ST_SOLID;
+	ElementType& t = sim.element_types[identifier];
+	t.colors = { sf::Color(159, 191, 254) };
+	color = t.colors[0];
+	t.mass = 1;
+	t.restitution = 0.1f;
+	t.pile_threshold = 0;
+	t.temperature = 245.15f;
+	t.thermal_cond = 2.18f;
+	t.specific_heat_cap = 0.50f;
+	t.state = ST_SOLID;
 	this->sim = &sim;
-	high_temperature = 273.15f;
-	high_temperature_transition = EL_WATER;
+	t.high_temperature = 273.15f;
+	t.high_temperature_transition = EL_WATER;
 }
 
-Ice::Ice(const Ice & rhs)
-{
-	Element::element_copy(rhs);
-	color = colors[random.between(0, colors.size() - 1)];
-}
-
-
 Ice::~Ice()
 {
 }
@@ -1,12 +1,9 @@
 #pragma once
 #include "Element/Element.h"
-class Ice :
+class Ice final :
 	public Element
 {
 public:
 	Ice(Simulation& sim);
-	Ice(const Ice& rhs);
 	~Ice();
-protected:
-	Element * clone_impl() const override;
 };
\ No newline at end of file
@@ -2,47 +2,37 @@
 #include "Simulation.h"
 #include "Utils/Random.h"
 
-int Lava::update(float dt)
+int Lava::update(int p, float dt)
 {
-	int id = Element::update(dt);
+	int id = Element::update(p, dt);
+	int previous_id = sim->particles.previous_id[p];
 	if (previous_id != EL_NONE_ID 
 		&& id != identifier)
 		id = previous_id;
 	return id;
 }
 
-Element* Lava::clone_impl() const
-{
-	return new Lava(*this);
-}
-
 Lava::Lava(Simulation& sim)
 {
 	identifier = EL_LAVA;
 	name = "Lava";
 	description = "Lava";
-	colors = { sf::Color(223, 79, 15) };
-	color = colors[0];
-	mass = 1;
-	restitution = 0.0f;
-	temperature = 1300.f;
-	thermal_cond = 4.f;
-	specific_heat_cap = 1.f;
-	endurance = 998;
-	state = ST_LIQUID;
-	prop = Igniter;
-	low_temperature = 1070.15f;
-	low_temperature_transition = EL_STONE;
+	ElementType& t = sim.element_types[identifier];
+	t.colors = { sf::Color(223, 79, 15) };
+	color = t.colors[0];
+	t.mass = 1;
+	t.restitution = 0.0f;
+	t.temperature = 1300.f;
+	t.thermal_cond = 4.f;
+	t.specific_heat_cap = 1.f;
+	t.endurance = 998;
+	t.state = ST_LIQUID;
+	t.prop = Igniter;
+	t.low_temperature = 1070.15f;
+	t.low_temperature_transition = EL_STONE;
 	this->sim = &sim;
 }
 
-Lava::Lava(const Lava& rhs)
-{
-	Element::element_copy(rhs);
-	color = colors[random.between(0, colors.size() - 1)];
-}
-
-
 Lava::~Lava()
 {
 }
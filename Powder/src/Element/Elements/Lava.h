@@ -1,13 +1,10 @@
 #pragma once
 #include "Element/Element.h"
-class Lava :
+class Lava final :
 	public Element
 {
 public:
-	int update(float dt) override;
+	int update(int p, float dt) override;
 	Lava(Simulation& sim);
-	Lava(const Lava& rhs);
 	~Lava();
-protected:
-	Element * clone_impl() const override;
 };
\ No newline at end of file
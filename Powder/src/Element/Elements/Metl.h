@@ -1,12 +1,9 @@
 #pragma once
 #include "Element/Element.h"
-class Metl :
+class Metl final :
 	public Element
 {
 public:
 	Metl(Simulation& sim);
-	Metl(const Metl& rhs);
 	~Metl();
-protected:
-	Element * clone_impl() const override;
 };
\ No newline at end of file
@@ -1,12 +1,9 @@
 #pragma once
 #include "Element/Element.h"
-class Nitr :
+class Nitr final :
 	public Element
 {
 public:
 	Nitr(Simulation& sim);
-	Nitr(const Nitr& rhs);
 	~Nitr();
-protected:
-	Element * clone_impl() const override;
 };
\ No newline at end of file
@@ -1,12 +1,9 @@
 #pragma once
 #include "Element/Element.h"
-class Oil :
+class Oil final :
 	public Element
 {
 public:
 	Oil(Simulation& sim);
-	Oil(const Oil& rhs);
 	~Oil();
-protected:
-	Element* clone_impl() const override;
 };
\ No newline at end of file
@@ -1,12 +1,9 @@
 #pragma once
 #include "Element/Element.h"
-class Sand :
+class Sand final :
 	public Element
 {
 public:
 	Sand(Simulation& sim);
-	Sand(const Sand& rhs);
 	~Sand();
-protected:
-	Element * clone_impl() const override;
 };
\ No newline at end of file
@@ -2,37 +2,27 @@
 #include "Simulation.h"
 #include "Utils/Random.h"
 
-Element* Stone::clone_impl() const
-{
-	return new Stone(*this);
-}
-
 Stone::Stone(Simulation& sim)
 {
 	identifier = EL_STONE;
 	name = "Stone";
 	description = "Stone";
-	colors = { sf::Color(159, 159, 159) };
-	color = colors[0];
-	mass = 5;
-	restitution = 0.f;
-	pile_threshold = 1;
-	temperature = 295.15f;
-	thermal_cond = 1.7f;
-	specific_heat_cap = 0.91f;
-	endurance = 999;
-	state = ST_POWDER;
-	high_temperature = 1073.15f;
-	high_temperature_transition = EL_LAVA;
+	ElementType& t = sim.element_types[identifier];
+	t.colors = { sf::Color(159, 159, 159) };
+	color = t.colors[0];
+	t.mass = 5;
+	t.restitution = 0.f;
+	t.pile_threshold = 1;
+	t.temperature = 295.15f;
+	t.thermal_cond = 1.7f;
+	t.specific_heat_cap = 0.91f;
+	t.endurance = 999;
+	t.state = ST_POWDER;
+	t.high_temperature = 1073.15f;
+	t.high_temperature_transition = EL_LAVA;
 	this->sim = &sim;
 }
 
-Stone::Stone(const Stone& rhs)
-{
-	Element::element_copy(rhs);
-}
-
-
 Stone::~Stone()
 {
 }
@@ -1,12 +1,9 @@
 #pragma once
 #include "Element/Element.h"
-class Stone :
+class Stone final :
 	public Element
 {
 public:
 	Stone(Simulation& sim);
-	Stone(const Stone& rhs);
 	~Stone();
-protected:
-	Element * clone_impl() const override;
 };
\ No newline at end of file
@@ -2,31 +2,20 @@
 #include "Simulation.h"
 #include "Utils/Random.h"
 
-Element* WALL::clone_impl() const
-{
-	return new WALL(*this);
-}
-
 WALL::WALL(Simulation& sim)
 {
 	identifier = EL_WALL;
 	name = "WALL";
 	description = "WALL GOL Rule";
 	rule_string = "s2345/b45678";
-	state = ST_SOLID;
-	colors = { sf::Color(33, 77, 255) };
-	color = colors[0];
+	ElementType& t = sim.element_types[identifier];
+	t.state = ST_SOLID;
+	t.colors = { sf::Color(33, 77, 255) };
+	color = t.colors[0];
 	process_rules();
 	this->sim = &sim;
 }
 
-WALL::WALL(const WALL& rhs)
-{
-	Element::element_copy(rhs);
-	rule_string = rhs.rule_string;
-	process_rules();
-}
-
 WALL::~WALL()
 {
 }
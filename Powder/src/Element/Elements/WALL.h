@@ -1,12 +1,9 @@
 #pragma once
 #include "GOL.h"
-class WALL :
+class WALL final :
 	public GOL
 {
 public:
 	WALL(Simulation& sim);
-	WALL(const WALL& rhs);
 	~WALL();
-protected:
-	Element * clone_impl() const override;
 };
\ No newline at end of file
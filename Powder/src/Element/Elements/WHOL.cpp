@@ -2,19 +2,11 @@
 #include "Simulation.h"
 #include "Utils/Random.h"
 
-Element* WHOL::clone_impl() const
+int WHOL::update(int p, float dt)
 {
-	return new WHOL(*this);
-}
-
-int WHOL::update(float dt)
-{
-	if (mass < sim->gravity.mass_th)
-	{
-		sim->gravity.update_mass(mass, -1, -1, x, y);
-		mass = -sim->gravity.mass_th;
-		sim->gravity.update_mass(mass, x, y, -1, -1);
-	}
+	ParticleStore& ps = sim->particles;
+	if (ps.mass[p] < sim->gravity.mass_th)
+		ps.mass[p] = -sim->gravity.mass_th;
 	return identifier;
 }
 
@@ -23,24 +15,19 @@ WHOL::WHOL(Simulation& sim)
 	identifier = EL_WHOL;
 	name = "WHOL";
 	description = "Mass always equal to the negative of the mass threshold of the gravity. Needs newtonian gravity to work";
-	colors = { sf::Color::White };
-	color = colors[0];
-	mass = -sim.gravity.mass_th;
-	restitution = 0.f;
-	temperature = 295.15f;
-	thermal_cond = 1.f;
-	specific_heat_cap = 1.f;
-	endurance = 1000;
-	state = ST_SOLID;
+	ElementType& t = sim.element_types[identifier];
+	t.colors = { sf::Color::White };
+	color = t.colors[0];
+	t.mass = -sim.gravity.mass_th;
+	t.restitution = 0.f;
+	t.temperature = 295.15f;
+	t.thermal_cond = 1.f;
+	t.specific_heat_cap = 1.f;
+	t.endurance = 1000;
+	t.state = ST_SOLID;
 	this->sim = &sim;
 }
 
-WHOL::WHOL(const WHOL& rhs)
-{
-	Element::element_copy(rhs);
-}
-
-
 WHOL::~WHOL()
 {
 }
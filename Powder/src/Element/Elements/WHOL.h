@@ -1,13 +1,10 @@
 #pragma once
 #include "Element/Element.h"
-class WHOL :
+class WHOL final :
 	public Element
 {
 public:
-	int update(float dt) override;
+	int update(int p, float dt) override;
 	WHOL(Simulation& sim);
-	WHOL(const WHOL& rhs);
 	~WHOL();
-protected:
-	Element * clone_impl() const override;
 };
\ No newline at end of file
@@ -1,12 +1,9 @@
 #pragma once
 #include "Element/Element.h"
-class Water :
+class Water final :
 	public Element
 {
 public:
 	Water(Simulation& sim);
-	Water(const Water& rhs);
 	~Water();
-protected:
-	Element * clone_impl() const override;
 };
\ No newline at end of file
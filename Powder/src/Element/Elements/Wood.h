@@ -1,12 +1,9 @@
 #pragma once
 #include "Element/Element.h"
-class Wood :
+class Wood final :
 	public Element
 {
 public:
 	Wood(Simulation& sim);
-	Wood(const Wood& rhs);
 	~Wood();
-protected:
-	Element * clone_impl() const override;
 };
\ No newline at end of file
@@ -1,12 +1,9 @@
 #pragma once
 #include "Element/Element.h"
-class Wtrv :
+class Wtrv final :
 	public Element
 {
 public:
 	Wtrv(Simulation& sim);
-	Wtrv(const Wtrv& rhs);
 	~Wtrv();
-protected:
-	Element * clone_impl() const override;
 };
\ No newline at end of file
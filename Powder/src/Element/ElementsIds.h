@@ -15,6 +15,8 @@ static inline int IDX(int x, int y, int w)
 //ELEMENT_IDS
 #define EL_NONE nullptr
 #define EL_NONE_ID 0
+// Particle index of empty cells
+#define PT_NONE -1
 #define EL_ACID 1
 #define EL_BHOL 2
 #define EL_BRICK 3
@@ -39,3 +41,4 @@ static inline int IDX(int x, int y, int w)
 #define EL_WHOL 22
 #define EL_WOOD 23
 #define EL_WTRV 24
+#define EL_COUNT 25
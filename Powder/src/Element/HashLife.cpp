@@ -0,0 +1,301 @@
+#include "HashLife.h"
+#include <algorithm>
+
+size_t HashLife::KeyHash::operator()(const Key& key) const
+{
+	uint64_t h = static_cast<uint32_t>(key.nw);
+	h = h * 0x9e3779b97f4a7c15ULL + static_cast<uint32_t>(key.ne);
+	h = h * 0x9e3779b97f4a7c15ULL + static_cast<uint32_t>(key.sw);
+	h = h * 0x9e3779b97f4a7c15ULL + static_cast<uint32_t>(key.se);
+	return static_cast<size_t>(h ^ (h >> 32));
+}
+
+bool HashLife::advance(const std::vector<uint64_t>& board, int cells_x, int cells_y,
+	int steps_log2, uint16_t birth_mask, uint16_t survive_mask,
+	std::vector<uint64_t>& next)
+{
+	// the results only hold for the step and the rule they were computed with
+	if (steps_log2 != this->steps_log2 || birth_mask != this->birth_mask
+		|| survive_mask != this->survive_mask)
+	{
+		clear();
+		this->steps_log2 = steps_log2;
+		this->birth_mask = birth_mask;
+		this->survive_mask = survive_mask;
+	}
+	// the pattern doesn't fit, the cells are left to the caller
+	if (overflows >= HASHLIFE_MAX_OVERFLOWS)
+		return false;
+	// collecting again before the cache doubled would only find the same nodes
+	if (nodes.size() > HASHLIFE_MAX_NODES / 2 && nodes.size() > 2 * collected)
+		collect();
+	this->board = &board;
+	this->cells_x = cells_x;
+	this->cells_y = cells_y;
+	row_words = (cells_x + 63) / 64;
+	// the grid fills the center half of the root,
+	// which is also the part its successor covers
+	int level = 2;
+	while ((1 << (level - 1)) < std::max(cells_x, cells_y) || level - 2 < steps_log2)
+		level++;
+	int offset = 1 << (level - 2);
+	int root = build(level, -offset, -offset);
+	int res = successor(root);
+	this->board = nullptr;
+	if (overflow)
+	{
+		// the nodes of the last pattern are kept for the next try
+		overflow = false;
+		overflows++;
+		collect();
+		return false;
+	}
+	overflows = 0;
+	last_root = root;
+	next.assign(board.size(), 0);
+	write(res, 0, 0, next);
+	return true;
+}
+
+void HashLife::clear()
+{
+	nodes.clear();
+	table.clear();
+	empty.clear();
+	overflow = false;
+	overflows = 0;
+	last_root = -1;
+	collected = 0;
+	nodes.push_back({ -1, -1, -1, -1, 0, -1 });
+	nodes.push_back({ -1, -1, -1, -1, 0, -1 });
+}
+
+int HashLife::join(int nw, int ne, int sw, int se)
+{
+	Key key = { nw, ne, sw, se };
+	auto it = table.find(key);
+	if (it != table.end())
+		return it->second;
+	int node = static_cast<int>(nodes.size());
+	// the node is still added so the callers get a valid one,
+	// they return right away once overflow is set
+	if (node >= HASHLIFE_MAX_NODES)
+		overflow = true;
+	nodes.push_back({ nw, ne, sw, se, nodes[nw].level + 1, -1 });
+	table.emplace(key, node);
+	return node;
+}
+
+int HashLife::empty_node(int level)
+{
+	while (static_cast<int>(empty.size()) <= level)
+	{
+		int e = empty.empty() ? 0 : empty.back();
+		empty.push_back(empty.empty() ? 0 : join(e, e, e, e));
+	}
+	return empty[level];
+}
+
+bool HashLife::area_empty(int x, int y, int size) const
+{
+	int x0 = std::max(x, 0), x1 = std::min(x + size, cells_x);
+	int y0 = std::max(y, 0), y1 = std::min(y + size, cells_y);
+	if (x0 >= x1 || y0 >= y1)
+		return true;
+	for (int row = y0; row < y1; row++)
+	{
+		const uint64_t* words = &(*board)[row * row_words];
+		for (int cx = x0; cx < x1; cx = (cx | 63) + 1)
+		{
+			int end = std::min(x1, (cx | 63) + 1);
+			// the bits from cx to end - 1 of the word
+			uint64_t mask = ~0ULL << (cx & 63);
+			if (end & 63)
+				mask &= ~(~0ULL << (end & 63));
+			if (words[cx >> 6] & mask)
+				return false;
+		}
+	}
+	return true;
+}
+
+int HashLife::build(int level, int x, int y)
+{
+	if (level == 0)
+	{
+		bool alive = x >= 0 && y >= 0 && x < cells_x && y < cells_y
+			&& ((*board)[y * row_words + (x >> 6)] >> (x & 63)) & 1;
+		return alive ? 1 : 0;
+	}
+	// small nodes are cheaper to build than to check
+	if (overflow || (level >= 3 && area_empty(x, y, 1 << level)))
+		return empty_node(level);
+	int half = 1 << (level - 1);
+	return join(build(level - 1, x, y), build(level - 1, x + half, y),
+		build(level - 1, x, y + half), build(level - 1, x + half, y + half));
+}
+
+int HashLife::base_case(int node)
+{
+	int quads[4] = { nodes[node].nw, nodes[node].ne, nodes[node].sw, nodes[node].se };
+	// bit r * 4 + c is the cell in row r and column c
+	unsigned int cells = 0;
+	for (int r = 0; r < 4; r++)
+	{
+		for (int c = 0; c < 4; c++)
+		{
+			const Node& q = nodes[quads[(r / 2) * 2 + c / 2]];
+			int leaf = r % 2 ? (c % 2 ? q.se : q.sw) : (c % 2 ? q.ne : q.nw);
+			if (leaf == 1)
+				cells |= 1u << (r * 4 + c);
+		}
+	}
+	int next[4];
+	for (int i = 0; i < 4; i++)
+	{
+		int r = 1 + i / 2, c = 1 + i % 2;
+		int count = 0;
+		for (int dr = -1; dr <= 1; dr++)
+			for (int dc = -1; dc <= 1; dc++)
+				if (dr || dc)
+					count += (cells >> ((r + dr) * 4 + c + dc)) & 1;
+		bool alive = (cells >> (r * 4 + c)) & 1;
+		next[i] = ((alive ? survive_mask : birth_mask) >> count) & 1;
+	}
+	return join(next[0], next[1], next[2], next[3]);
+}
+
+int HashLife::successor(int node)
+{
+	if (nodes[node].result != -1)
+		return nodes[node].result;
+	int level = nodes[node].level;
+	// the result is thrown away, it only has to be a node of the right level
+	if (overflow)
+		return empty_node(level - 1);
+	int res;
+	// nothing is born without alive neighbours
+	if (node == empty_node(level))
+	{
+		res = empty_node(level - 1);
+	}
+	else if (level == 2)
+	{
+		res = base_case(node);
+	}
+	else
+	{
+		// nodes might move while joining, so copies are used
+		Node n = nodes[node];
+		Node a = nodes[n.nw], b = nodes[n.ne], c = nodes[n.sw], d = nodes[n.se];
+		// the nine overlapping squares of half the size, advanced
+		int c1 = successor(n.nw);
+		int c2 = successor(join(a.ne, b.nw, a.se, b.sw));
+		int c3 = successor(n.ne);
+		int c4 = successor(join(a.sw, a.se, c.nw, c.ne));
+		int c5 = successor(join(a.se, b.sw, c.ne, d.nw));
+		int c6 = successor(join(b.sw, b.se, d.nw, d.ne));
+		int c7 = successor(n.sw);
+		int c8 = successor(join(c.ne, d.nw, c.se, d.sw));
+		int c9 = successor(n.se);
+		if (steps_log2 < level - 2)
+		{
+			// enough time has passed, only their centers are put together
+			int q1 = join(nodes[c1].se, nodes[c2].sw, nodes[c4].ne, nodes[c5].nw);
+			int q2 = join(nodes[c2].se, nodes[c3].sw, nodes[c5].ne, nodes[c6].nw);
+			int q3 = join(nodes[c4].se, nodes[c5].sw, nodes[c7].ne, nodes[c8].nw);
+			int q4 = join(nodes[c5].se, nodes[c6].sw, nodes[c8].ne, nodes[c9].nw);
+			res = join(q1, q2, q3, q4);
+		}
+		else
+		{
+			int q1 = successor(join(c1, c2, c4, c5));
+			int q2 = successor(join(c2, c3, c5, c6));
+			int q3 = successor(join(c4, c5, c7, c8));
+			int q4 = successor(join(c5, c6, c8, c9));
+			res = join(q1, q2, q3, q4);
+		}
+	}
+	// results computed after the overflow are wrong
+	if (!overflow)
+		nodes[node].result = res;
+	return res;
+}
+
+void HashLife::collect()
+{
+	std::vector<int> remap(nodes.size(), -1);
+	std::vector<Node> kept;
+	keep(0, remap, kept);
+	keep(1, remap, kept);
+	for (int& e : empty)
+		e = keep(e, remap, kept);
+	if (last_root != -1)
+		last_root = keep(last_root, remap, kept);
+	nodes.swap(kept);
+	table.clear();
+	for (size_t i = 2; i < nodes.size(); i++)
+	{
+		const Node& n = nodes[i];
+		table.emplace(Key{ n.nw, n.ne, n.sw, n.se }, static_cast<int>(i));
+	}
+	collected = nodes.size();
+}
+
+int HashLife::keep(int node, std::vector<int>& remap, std::vector<Node>& kept) const
+{
+	if (remap[node] != -1)
+		return remap[node];
+	Node n = nodes[node];
+	// the quadrants and the result are smaller, so this ends
+	if (n.level > 0)
+	{
+		n.nw = keep(n.nw, remap, kept);
+		n.ne = keep(n.ne, remap, kept);
+		n.sw = keep(n.sw, remap, kept);
+		n.se = keep(n.se, remap, kept);
+	}
+	if (n.result != -1)
+		n.result = keep(n.result, remap, kept);
+	remap[node] = static_cast<int>(kept.size());
+	kept.push_back(n);
+	return remap[node];
+}
+
+void HashLife::write(int node, int x, int y, std::vector<uint64_t>& next) const
+{
+	int level = nodes[node].level;
+	if (x >= cells_x || y >= cells_y
+		|| (level < static_cast<int>(empty.size()) && node == empty[level]))
+		return;
+	if (level == 0)
+	{
+		next[y * row_words + (x >> 6)] |= 1ULL << (x & 63);
+		return;
+	}
+	int half = 1 << (level - 1);
+	write(nodes[node].nw, x, y, next);
+	write(nodes[node].ne, x + half, y, next);
+	write(nodes[node].sw, x, y + half, next);
+	write(nodes[node].se, x + half, y + half, next);
+}
+
+HashLife::HashLife() :
+	steps_log2(-1),
+	birth_mask(0),
+	survive_mask(0),
+	board(nullptr),
+	cells_x(0),
+	cells_y(0),
+	row_words(0),
+	overflow(false),
+	overflows(0),
+	last_root(-1),
+	collected(0)
+{
+	clear();
+}
+
+HashLife::~HashLife()
+{
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <stdint.h>
+
+// Nodes the cache can hold. Past half of them the nodes not reachable
+// from the last pattern are thrown away, an advance that needs more is given up
+#define HASHLIFE_MAX_NODES (1 << 21)
+// Advances given up in a row before HashLife stops being used
+// until the rule or the step changes
+#define HASHLIFE_MAX_OVERFLOWS 3
+
+// Memoized quadtree (HashLife) for advancing a Life pattern
+// many generations at once. Every distinct square of cells
+// is stored once, together with its center advanced in time,
+// so repeating patterns are only computed the first time.
+// The pattern has to stay away from the edges of the grid,
+// nothing is born outside of it.
+class HashLife
+{
+public:
+	// Advances the cells of the board (64 cells of a row per word)
+	// 2^steps_log2 generations and writes them to next.
+	// The rule masks have bit n set if n alive neighbours
+	// cause a birth or survival.
+	// False if the pattern needs more than HASHLIFE_MAX_NODES nodes,
+	// or did so HASHLIFE_MAX_OVERFLOWS times in a row
+	bool advance(const std::vector<uint64_t>& board, int cells_x, int cells_y,
+		int steps_log2, uint16_t birth_mask, uint16_t survive_mask,
+		std::vector<uint64_t>& next);
+	void clear();
+	HashLife();
+	~HashLife();
+private:
+	struct Node
+	{
+		// Indices of the quadrants, -1 for the single cells
+		int nw, ne, sw, se;
+		int level; // the node covers 2^level by 2^level cells
+		// The center advanced 2^min(steps_log2, level - 2) generations,
+		// -1 until it's needed
+		int result;
+	};
+	struct Key
+	{
+		int nw, ne, sw, se;
+		bool operator==(const Key& other) const
+		{
+			return nw == other.nw && ne == other.ne && sw == other.sw && se == other.se;
+		}
+	};
+	struct KeyHash
+	{
+		size_t operator()(const Key& key) const;
+	};
+	// 0 and 1 are the dead and the alive cell
+	std::vector<Node> nodes;
+	std::unordered_map<Key, int, KeyHash> table;
+	// The node without any alive cell of every level
+	std::vector<int> empty;
+	// What the results were computed for
+	int steps_log2;
+	uint16_t birth_mask, survive_mask;
+	// The board being read while building the tree
+	const std::vector<uint64_t>* board;
+	int cells_x, cells_y, row_words;
+	// Set by join once the cache is full, the advance
+	// then unwinds without computing anything else
+	bool overflow;
+	int overflows;
+	// Root of the last advance that went through, -1 if there's none
+	int last_root;
+	// Nodes left by the last collect
+	size_t collected;
+	// Keeps the nodes reachable from last_root through their
+	// quadrants and results, and the empty nodes
+	void collect();
+	int keep(int node, std::vector<int>& remap, std::vector<Node>& kept) const;
+	int join(int nw, int ne, int sw, int se);
+	int empty_node(int level);
+	// The node of the given level whose top left cell
+	// is at x, y of the grid, cells outside of it are dead
+	int build(int level, int x, int y);
+	bool area_empty(int x, int y, int size) const;
+	// The center of the node advanced in time
+	int successor(int node);
+	// One generation of the center of a 4x4 node
+	int base_case(int node);
+	void write(int node, int x, int y, std::vector<uint64_t>& next) const;
+};
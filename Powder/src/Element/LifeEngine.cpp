@@ -0,0 +1,308 @@
+#include "LifeEngine.h"
+#include "Simulation.h"
+#include "Element/Elements/GOL.h"
+#include <algorithm>
+
+// the neighbour on the left moved into the bit of the cell
+static inline uint64_t from_west(const uint64_t* row, int i)
+{
+	return (row[i] << 1) | (i > 0 ? row[i - 1] >> 63 : 0);
+}
+
+// the neighbour on the right moved into the bit of the cell
+static inline uint64_t from_east(const uint64_t* row, int i, int row_words)
+{
+	return (row[i] >> 1) | (i + 1 < row_words ? row[i + 1] << 63 : 0);
+}
+
+// Cells whose neighbour count (bits c0 to c3) is set in the rule mask
+static inline uint64_t apply_rule(uint16_t mask, uint64_t c0, uint64_t c1, uint64_t c2, uint64_t c3)
+{
+	uint64_t res = 0;
+	for (int n = 0; n < 9; n++)
+	{
+		if (mask & (1 << n))
+		{
+			res |= (n & 1 ? c0 : ~c0) & (n & 2 ? c1 : ~c1)
+				& (n & 4 ? c2 : ~c2) & (n & 8 ? c3 : ~c3);
+		}
+	}
+	return res;
+}
+
+// Index of the lowest set bit, through a de Bruijn sequence
+// since the bit scan intrinsics aren't available everywhere
+static inline int lowest_bit(uint64_t word)
+{
+	static const int table[64] = {
+		0, 1, 48, 2, 57, 49, 28, 3, 61, 58, 50, 42, 38, 29, 17, 4,
+		62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12, 5,
+		63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+		46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19, 9, 13, 8, 7, 6
+	};
+	return table[((word & (~word + 1)) * 0x03f79d71b4cb0a89ULL) >> 58];
+}
+
+void LifeEngine::add_element(int id)
+{
+	if (id >= static_cast<int>(alive.size()))
+	{
+		alive.resize(id + 1);
+		born.resize(id + 1);
+		died.resize(id + 1);
+		decay.resize(id + 1);
+		live.resize(id + 1);
+	}
+	ids.push_back(id);
+	resize(cells_x, cells_y);
+}
+
+void LifeEngine::set_cell(int x, int y, int id)
+{
+	int w = y * row_words + (x >> 6);
+	uint64_t bit = 1ULL << (x & 63);
+	for (int gol : ids)
+	{
+		alive[gol][w] &= ~bit;
+		for (auto& plane : decay[gol])
+			plane[w] &= ~bit;
+	}
+	if (id == EL_NONE_ID)
+	{
+		occupied[w] &= ~bit;
+		return;
+	}
+	occupied[w] |= bit;
+	if (id < static_cast<int>(alive.size()) && !alive[id].empty())
+		alive[id][w] |= bit;
+}
+
+void LifeEngine::rebuild(const Simulation& sim)
+{
+	std::fill(occupied.begin(), occupied.end(), 0);
+	for (int id : ids)
+	{
+		std::fill(alive[id].begin(), alive[id].end(), 0);
+		for (auto& plane : decay[id])
+			std::fill(plane.begin(), plane.end(), 0);
+	}
+	for (int y = 0; y < cells_y; y++)
+	{
+		for (int x = 0; x < cells_x; x++)
+		{
+			int p = sim.get_from_grid(x, y);
+			if (p != PT_NONE)
+				set_cell(x, y, sim.particles.type[p]);
+		}
+	}
+}
+
+void LifeEngine::step(Simulation& sim)
+{
+	if (hashlife_speed <= 0 || !advance_hashlife(sim))
+		advance_bitboards(sim);
+	// only the cells that changed are written back
+	for (int id : ids)
+	{
+		for (size_t w = 0; w < occupied.size(); w++)
+		{
+			int x0 = static_cast<int>(w % row_words) * 64, y = static_cast<int>(w / row_words);
+			for (uint64_t bits = died[id][w]; bits; bits &= bits - 1)
+				sim.destroy_element(x0 + lowest_bit(bits), y);
+			for (uint64_t bits = born[id][w]; bits; bits &= bits - 1)
+				sim.create_element(id, false, true, x0 + lowest_bit(bits), y);
+		}
+	}
+}
+
+bool LifeEngine::advance_hashlife(Simulation& sim)
+{
+	// the other elements and GOL elements with another rule
+	// are left to the bitboards
+	int single = EL_NONE_ID;
+	for (int id : ids)
+		if (alive[id] == occupied)
+			single = id;
+	if (single == EL_NONE_ID)
+		return false;
+	const GOL* gol = static_cast<const GOL*>(sim.find_by_id(single));
+	// births without neighbours would fill the whole plane,
+	// lingering cells aren't part of the quadtree
+	if ((gol->birth_mask & 1) || gol->decay > 0)
+		return false;
+	// nothing may get close enough to the edges to be born outside
+	int margin = 1 << hashlife_speed;
+	int min_x = cells_x, max_x = -1, min_y = cells_y, max_y = -1;
+	for (int y = 0; y < cells_y; y++)
+	{
+		for (int i = 0; i < row_words; i++)
+		{
+			uint64_t word = occupied[y * row_words + i];
+			if (!word)
+				continue;
+			min_y = std::min(min_y, y);
+			max_y = y;
+			min_x = std::min(min_x, i * 64 + lowest_bit(word));
+			for (int bit = 63; bit >= 0; bit--)
+			{
+				if ((word >> bit) & 1)
+				{
+					max_x = std::max(max_x, i * 64 + bit);
+					break;
+				}
+			}
+		}
+	}
+	if (max_x < 0 || min_x - margin < 0 || min_y - margin < 0
+		|| max_x + margin >= cells_x || max_y + margin >= cells_y)
+		return false;
+	// patterns too big for the cache are left to the bitboards
+	if (!hashlife.advance(alive[single], cells_x, cells_y, hashlife_speed,
+		gol->birth_mask, gol->survive_mask, next))
+		return false;
+	for (int id : ids)
+	{
+		for (size_t w = 0; w < occupied.size(); w++)
+		{
+			born[id][w] = id == single ? next[w] & ~alive[id][w] : 0;
+			died[id][w] = id == single ? alive[id][w] & ~next[w] : 0;
+		}
+	}
+	return true;
+}
+
+void LifeEngine::advance_bitboards(Simulation& sim)
+{
+	size_t size = occupied.size();
+	// a plane per bit of the decay, the counters are
+	// thrown away when the rule changes
+	bool lingering = false;
+	for (int id : ids)
+	{
+		int decay_generations = static_cast<const GOL*>(sim.find_by_id(id))->decay;
+		size_t planes = 0;
+		while ((1 << planes) <= decay_generations)
+			planes++;
+		if (decay[id].size() != planes)
+			decay[id].assign(planes, std::vector<uint64_t>(size, 0));
+		lingering |= planes > 0;
+	}
+	const std::vector<uint64_t>* neighbours = &occupied;
+	if (lingering)
+	{
+		counted = occupied;
+		for (int id : ids)
+		{
+			live[id] = alive[id];
+			for (auto& plane : decay[id])
+			{
+				for (size_t w = 0; w < size; w++)
+				{
+					live[id][w] &= ~plane[w];
+					counted[w] &= ~plane[w];
+				}
+			}
+		}
+		neighbours = &counted;
+	}
+	// cells past the right edge of the grid in the last word
+	uint64_t last_mask = (cells_x & 63) ? (1ULL << (cells_x & 63)) - 1 : ~0ULL;
+	for (int y = 0; y < cells_y; y++)
+	{
+		const uint64_t* up = y > 0 ? &(*neighbours)[(y - 1) * row_words] : empty_row.data();
+		const uint64_t* mid = &(*neighbours)[y * row_words];
+		const uint64_t* down = y + 1 < cells_y ? &(*neighbours)[(y + 1) * row_words] : empty_row.data();
+		for (int i = 0; i < row_words; i++)
+		{
+			// the 8 neighbours of every cell summed into the count bits
+			// c0 to c3 with full adders (sum, carry)
+			uint64_t a = from_west(up, i), b = up[i], c = from_east(up, i, row_words);
+			uint64_t d = from_west(mid, i), e = from_east(mid, i, row_words);
+			uint64_t f = from_west(down, i), g = down[i], h = from_east(down, i, row_words);
+			uint64_t s_abc = a ^ b ^ c, k_abc = (a & b) | (c & (a ^ b));
+			uint64_t s_def = d ^ e ^ f, k_def = (d & e) | (f & (d ^ e));
+			uint64_t s_gh = g ^ h, k_gh = g & h;
+			uint64_t c0 = s_abc ^ s_def ^ s_gh;
+			uint64_t k_ones = (s_abc & s_def) | (s_gh & (s_abc ^ s_def));
+			// the twos: k_abc + k_def + k_gh + k_ones
+			uint64_t s_twos = k_abc ^ k_def ^ k_gh;
+			uint64_t k_twos = (k_abc & k_def) | (k_gh & (k_abc ^ k_def));
+			uint64_t c1 = s_twos ^ k_ones;
+			uint64_t k_fours = s_twos & k_ones;
+			uint64_t c2 = k_twos ^ k_fours;
+			uint64_t c3 = k_twos & k_fours;
+
+			int w = y * row_words + i;
+			// lingering cells can't be born into either
+			uint64_t free_cells = ~occupied[w];
+			if (i + 1 == row_words)
+				free_cells &= last_mask;
+			for (int id : ids)
+			{
+				const GOL* gol = static_cast<const GOL*>(sim.find_by_id(id));
+				const std::vector<uint64_t>& cells = lingering ? live[id] : alive[id];
+				const uint64_t* a_up = y > 0 ? &cells[(y - 1) * row_words] : empty_row.data();
+				const uint64_t* a_mid = &cells[y * row_words];
+				const uint64_t* a_down = y + 1 < cells_y ? &cells[(y + 1) * row_words] : empty_row.data();
+				uint64_t near = from_west(a_up, i) | a_up[i] | from_east(a_up, i, row_words)
+					| from_west(a_mid, i) | from_east(a_mid, i, row_words)
+					| from_west(a_down, i) | a_down[i] | from_east(a_down, i, row_words);
+				// a cell next to several GOL elements goes to the first one
+				uint64_t births = free_cells & near & apply_rule(gol->birth_mask, c0, c1, c2, c3);
+				free_cells &= ~births;
+				born[id][w] = births;
+				uint64_t fails = a_mid[i] & ~apply_rule(gol->survive_mask, c0, c1, c2, c3);
+				if (decay[id].empty())
+				{
+					died[id][w] = fails;
+					continue;
+				}
+				// the lingering cells count down by one, bit-sliced,
+				// the ones reaching zero die
+				uint64_t counting = 0, left = 0, borrow;
+				for (auto& plane : decay[id])
+					counting |= plane[w];
+				borrow = counting;
+				for (auto& plane : decay[id])
+				{
+					uint64_t bits = plane[w];
+					plane[w] = bits ^ borrow;
+					borrow &= ~bits;
+					left |= plane[w];
+				}
+				died[id][w] = counting & ~left;
+				// the ones failing to survive start lingering
+				for (size_t k = 0; k < decay[id].size(); k++)
+					if ((gol->decay >> k) & 1)
+						decay[id][k][w] |= fails;
+			}
+		}
+	}
+}
+
+void LifeEngine::resize(int cells_x, int cells_y)
+{
+	this->cells_x = cells_x;
+	this->cells_y = cells_y;
+	row_words = (cells_x + 63) / 64;
+	size_t size = static_cast<size_t>(row_words) * cells_y;
+	occupied.assign(size, 0);
+	empty_row.assign(row_words, 0);
+	for (int id : ids)
+	{
+		alive[id].assign(size, 0);
+		born[id].assign(size, 0);
+		died[id].assign(size, 0);
+		for (auto& plane : decay[id])
+			plane.assign(size, 0);
+	}
+}
+
+LifeEngine::LifeEngine(int cells_x, int cells_y)
+{
+	resize(cells_x, cells_y);
+}
+
+LifeEngine::~LifeEngine()
+{
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <vector>
+#include <stdint.h>
+#include "Element/HashLife.h"
+
+class Simulation;
+
+// Runs the elements derived from GOL on bitboards, every word
+// holds 64 cells of a row. Any particle counts as an alive neighbour,
+// a cell is only born if it is empty and next to a particle
+// of the element giving birth to it.
+// The boards are kept up to date through set_cell, a whole
+// generation is then computed with bit-sliced adders.
+// Cells of elements with a decay rule linger after failing to survive,
+// they keep their particle but aren't counted as alive neighbours.
+// The generations they have left are kept in bit-planes.
+class LifeEngine
+{
+public:
+	// Generations per tick as a power of two, used when the grid only
+	// holds a single GOL element far enough from the edges to be
+	// advanced through HashLife. 0 advances one generation per tick
+	int hashlife_speed = 0;
+	// Adds a board for the GOL element
+	void add_element(int id);
+	// Updates the boards for the cell, id is the element
+	// of the particle now in it or EL_NONE_ID if it's empty
+	void set_cell(int x, int y, int id);
+	// Fills the boards from the particles in the simulation
+	void rebuild(const Simulation& sim);
+	// Computes the next generation of every GOL element and
+	// creates or destroys the particles of the cells that changed
+	void step(Simulation& sim);
+	void resize(int cells_x, int cells_y);
+	LifeEngine(int cells_x, int cells_y);
+	~LifeEngine();
+private:
+	int cells_x, cells_y;
+	// Words in a row of a board
+	int row_words;
+	// Cells holding any particle
+	std::vector<uint64_t> occupied;
+	// Cells holding a particle of the element, indexed by the identifier,
+	// only the GOL elements have a board
+	std::vector<std::vector<uint64_t>> alive;
+	// Births and deaths of the next generation, same layout as alive
+	std::vector<std::vector<uint64_t>> born, died;
+	// Generations the lingering cells of every element have left,
+	// bit k of the counter is in plane k. One plane per bit of GOL::decay
+	std::vector<std::vector<std::vector<uint64_t>>> decay;
+	// Alive neighbours (occupied cells that aren't lingering) and alive
+	// cells of every element that aren't lingering, only filled
+	// while something can linger
+	std::vector<uint64_t> counted;
+	std::vector<std::vector<uint64_t>> live;
+	// Identifiers of the GOL elements
+	std::vector<int> ids;
+	// Used for the rows outside of the grid
+	std::vector<uint64_t> empty_row;
+	HashLife hashlife;
+	std::vector<uint64_t> next;
+	// Fills born and died with a single generation
+	void advance_bitboards(Simulation& sim);
+	// Fills born and died through HashLife,
+	// false if the grid or the size of the pattern doesn't allow it
+	bool advance_hashlife(Simulation& sim);
+};
@@ -0,0 +1,12 @@
+#pragma once
+#include <cstdint>
+
+// A handle keeps the index of the particle in the lower bits
+// and the generation of its slot in the upper ones, so a handle
+// to a destroyed particle no longer resolves once the slot is reused.
+// The index gets 32 bits so any grid the cell count allows fits
+typedef uint64_t ParticleHandle;
+#define PH_INDEX_BITS 32
+#define PH_INDEX_MASK ((1ull << PH_INDEX_BITS) - 1)
+#define PH_GENERATION_MASK 0xFFFFu
+#define PH_NONE 0xFFFFFFFFFFFFFFFFull
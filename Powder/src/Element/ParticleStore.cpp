@@ -0,0 +1,133 @@
+#include "ParticleStore.h"
+#include <algorithm>
+
+int ParticleStore::create(int id, int x, int y)
+{
+	int p = free_head;
+	if (p == PT_NONE)
+		return PT_NONE;
+	free_head = next_free[p];
+	type[p] = id;
+	set_pos(p, x, y, true);
+	vel_x[p] = 0.0f;
+	vel_y[p] = 0.0f;
+	speed[p] = 0.0f;
+	flags[p] = 0;
+	previous_id[p] = EL_NONE_ID;
+	collided[p] = PT_NONE;
+	coll_x[p] = 0;
+	coll_y[p] = 0;
+	return p;
+}
+
+void ParticleStore::destroy(int p)
+{
+	type[p] = EL_NONE_ID;
+	generation[p] = (generation[p] + 1) & PH_GENERATION_MASK;
+	next_free[p] = free_head;
+	free_head = p;
+}
+
+void ParticleStore::clear()
+{
+	// link every slot in order so the first particles
+	// created are close together in memory
+	for (int p = 0; p < capacity(); p++)
+	{
+		if (type[p] != EL_NONE_ID)
+		{
+			type[p] = EL_NONE_ID;
+			generation[p] = (generation[p] + 1) & PH_GENERATION_MASK;
+		}
+		next_free[p] = p + 1 < capacity() ? p + 1 : PT_NONE;
+	}
+	free_head = capacity() > 0 ? 0 : PT_NONE;
+}
+
+void ParticleStore::set_capacity(int capacity)
+{
+	resize(capacity);
+	clear();
+}
+
+ParticleHandle ParticleStore::handle(int p) const
+{
+	return static_cast<ParticleHandle>(p) | (static_cast<ParticleHandle>(generation[p]) << PH_INDEX_BITS);
+}
+
+int ParticleStore::resolve(ParticleHandle handle) const
+{
+	int p = static_cast<int>(handle & PH_INDEX_MASK);
+	if (handle == PH_NONE || p >= capacity() || type[p] == EL_NONE_ID
+		|| generation[p] != handle >> PH_INDEX_BITS)
+		return PT_NONE;
+	return p;
+}
+
+void ParticleStore::set_pos(int p, int x, int y, bool true_pos)
+{
+	this->x[p] = x;
+	this->y[p] = y;
+	if (true_pos)
+	{
+		pos_x[p] = static_cast<float> (x);
+		pos_y[p] = static_cast<float> (y);
+	}
+}
+
+Vector ParticleStore::get_pos(int p) const
+{
+	return Vector(pos_x[p], pos_y[p]);
+}
+
+Vector ParticleStore::get_velocity(int p) const
+{
+	return Vector(vel_x[p], vel_y[p]);
+}
+
+void ParticleStore::set_velocity(int p, Vector velocity)
+{
+	vel_x[p] = velocity.x;
+	vel_y[p] = velocity.y;
+}
+
+int ParticleStore::capacity() const
+{
+	return static_cast<int>(type.size());
+}
+
+void ParticleStore::resize(size_t size)
+{
+	type.resize(size, EL_NONE_ID);
+	x.resize(size);
+	y.resize(size);
+	pos_x.resize(size);
+	pos_y.resize(size);
+	vel_x.resize(size);
+	vel_y.resize(size);
+	speed.resize(size);
+	temperature.resize(size);
+	life.resize(size);
+	mass.resize(size);
+	state.resize(size);
+	prop.resize(size, NoProperties);
+	flags.resize(size);
+	previous_id.resize(size);
+	color.resize(size);
+	collided.resize(size);
+	coll_x.resize(size);
+	coll_y.resize(size);
+	list_slot.resize(size);
+	list_queue.resize(size);
+	generation.resize(size);
+	next_free.resize(size);
+}
+
+ParticleStore::ParticleStore() :
+	free_head(PT_NONE)
+{
+}
+
+ParticleStore::~ParticleStore()
+{
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include "Element/Element.h"
+#include "Element/ParticleHandle.h"
+#include "Utils/Vector.h"
+
+// Per particle flags that only live for the duration of an update
+#define PF_MOVED (1 << 0)
+#define PF_COLLISION (1 << 1)
+// Set while the particle waits in the add queue of the simulation
+#define PF_QUEUED (1 << 2)
+
+// Structure of arrays holding the state of every particle.
+// A particle is only an index into the arrays below, the element grid
+// and the active list store these indices instead of the elements themselves.
+// The Element classes describe the behaviour of a particle type
+// and read/write the arrays through the index they are given,
+// everything that is the same for all particles of an element
+// is kept in its ElementType instead.
+class ParticleStore
+{
+public:
+	// Identifier of the element the particle belongs to
+	// EL_NONE_ID marks a free slot
+	std::vector<int> type;
+	std::vector<int> x; // Current position in the grid of elements
+	std::vector<int> y; //
+	std::vector<float> pos_x; // Real position
+	std::vector<float> pos_y; //
+	std::vector<float> vel_x;
+	std::vector<float> vel_y;
+	std::vector<float> speed;
+	std::vector<float> temperature; //in kelvins
+	std::vector<float> life;
+	std::vector<float> mass;
+	std::vector<uint8_t> state;
+	std::vector<ElementProperties> prop;
+	std::vector<uint8_t> flags;
+	std::vector<int> previous_id;
+	// Index into the colors of the element
+	std::vector<uint8_t> color;
+	// The particle we collided with during the last move
+	// or PT_NONE if we collided with the edge of the grid
+	std::vector<int> collided;
+	// The position of the edge collision
+	std::vector<int> coll_x;
+	std::vector<int> coll_y;
+	// Position of the particle inside the active list, inside
+	// chunk_particles during a tick, or inside its queue if PF_QUEUED is set
+	std::vector<int> list_slot;
+	// Worker whose queue holds the particle, -1 for the add queue
+	std::vector<int8_t> list_queue;
+
+	// Takes a free slot and sets up the position of the particle,
+	// the rest of the state is filled in by Element::init_particle
+	// returns PT_NONE if the store is full
+	int create(int id, int x, int y);
+	// Frees the slot of the particle so it can be reused
+	void destroy(int p);
+	// Frees every slot, invalidating all handles
+	void clear();
+	// Allocates room for the given amount of particles and frees every slot,
+	// the arrays don't grow afterwards so creating and destroying
+	// particles never allocates
+	void set_capacity(int capacity);
+	// Makes a handle to the particle that can be kept between ticks
+	ParticleHandle handle(int p) const;
+	// Returns the particle the handle points to,
+	// or PT_NONE if the particle was destroyed
+	int resolve(ParticleHandle handle) const;
+	void set_pos(int p, int x, int y, bool true_pos = false);
+	Vector get_pos(int p) const;
+	Vector get_velocity(int p) const;
+	void set_velocity(int p, Vector velocity);
+	// The amount of slots, both used and free
+	int capacity() const;
+	ParticleStore();
+	~ParticleStore();
+private:
+	// Bumped every time the slot is freed
+	std::vector<uint16_t> generation;
+	// Intrusive free list, each free slot stores the next free one
+	std::vector<int> next_free;
+	int free_head;
+	void resize(size_t size);
+};
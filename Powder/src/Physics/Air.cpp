@@ -1,150 +1,403 @@
 #include "Air.h"
 #include "Simulation.h"
+#include "Utils/Simd.h"
 
 
-void Air::update_air()
+// The 3x3 blur of cell x, y, neighbours outside of the
+// inner part of the grid are replaced by the cell itself
+static inline float blur_edge(const float* data, int x, int y, int w, int h, const float* kernel)
 {
-	float dp = 0.0;
-	Vector t = Vector();
-	const float adv_dist_mult = 0.7f;
-	float stepX, stepY;
-	int stepLimit, step;
+	float sum = 0.0f;
+	for (int j = -1; j < 2; j++)
+	{
+		for (int i = -1; i < 2; i++)
+		{
+			bool inside = y + j > 0 && y + j < h - 1 && x + i > 0 && x + i < w - 1;
+			sum += data[inside ? (y + j) * w + x + i : y * w + x] * kernel[i + 1 + (j + 1) * 3];
+		}
+	}
+	return sum;
+}
+
+// The 3x3 blur of the cells x0 to x1 of the row starting at data,
+// all of their neighbours have to be in the inner part of the grid
+static void blur_inner(const float* data, float* out, int w, int x0, int x1, const float* kernel)
+{
+	int x = x0;
+	simd_float k[9];
+	for (int i = 0; i < 9; i++)
+		k[i] = simd_set(kernel[i]);
+	for (; x + SIMD_WIDTH <= x1; x += SIMD_WIDTH)
+	{
+		simd_float sum = simd_set(0.0f);
+		for (int j = -1; j < 2; j++)
+			for (int i = -1; i < 2; i++)
+				sum = simd_add(sum, simd_mul(simd_load(data + j * w + x + i), k[i + 1 + (j + 1) * 3]));
+		simd_store(out + x, sum);
+	}
+	for (; x < x1; x++)
+	{
+		float sum = 0.0f;
+		for (int j = -1; j < 2; j++)
+			for (int i = -1; i < 2; i++)
+				sum += data[j * w + x + i] * kernel[i + 1 + (j + 1) * 3];
+		out[x] = sum;
+	}
+}
+
+void Air::blur_row(const std::vector<float>& data, float* out, int y, int x0, int x1) const
+{
+	int w = grid_width;
+	// the edges are peeled off, only the inner cells go through blur_inner
+	int inner0 = x1, inner1 = x1;
+	if (y >= 2 && y < grid_height - 2)
+	{
+		inner0 = std::clamp(2, x0, x1);
+		inner1 = std::clamp(w - 2, inner0, x1);
+		blur_inner(&data[y * w], out, w, inner0, inner1, kernel);
+	}
+	for (int x = x0; x < inner0; x++)
+		out[x] = blur_edge(data.data(), x, y, w, grid_height, kernel);
+	for (int x = inner1; x < x1; x++)
+		out[x] = blur_edge(data.data(), x, y, w, grid_height, kernel);
+}
+
+void Air::update()
+{
+	int w = grid_width;
+	find_running_tiles();
+	if (ambient_heat)
+	{
+		// TODO make the edges in the game one bit smaller then the air grid so this works properly
+		// or make them bigger but dont display all of it
+		for (int i = 0; i < grid_height; i++)
+		{
+			int idx = i * w;
+			hv[idx] = amb_air_temp;
+			hv[idx + 1] = amb_air_temp;
+			hv[idx + w - 2] = amb_air_temp;
+			hv[idx + w - 1] = amb_air_temp;
+		}
+		for (int i = 0; i < w; i++)
+		{
+			hv[i] = amb_air_temp;
+			hv[w + i] = amb_air_temp;
+			hv[(grid_height - 2) * w + i] = amb_air_temp;
+			hv[(grid_height - 1) * w + i] = amb_air_temp;
+		}
+	}
 	//airMode 0 is no air/pressure update
 	if (air_mode != 0)
 	{
 		//reduces pressure/velocity on the edges every frame
 		for (int i = 0; i < grid_height; i++) 
 		{
-			int idx = i * grid_width;
+			int idx = i * w;
 			pv[idx] *= 0.8f;
 			pv[idx + 1] *= 0.8f;
 			pv[idx + 2] = pv[idx + 2] * 0.8f;
-			pv[idx + grid_width - 2] *= 0.8f;
-			pv[idx + grid_width - 1] *= 0.8f;
-
-			velocity[idx] *= 0.9f;
-			velocity[idx + 1] *= 0.9f;
-			velocity[idx + grid_width - 2] *= 0.9f;
-			velocity[idx + grid_width - 1] *= 0.9f;
+			pv[idx + w - 2] *= 0.8f;
+			pv[idx + w - 1] *= 0.8f;
+			for (int x : { idx, idx + 1, idx + w - 2, idx + w - 1 })
+			{
+				vx[x] *= 0.9f;
+				vy[x] *= 0.9f;
+			}
 		}
 		//reduces pressure/velocity on the edges every frame
-		for (int i = 0; i < grid_width; i++) 
+		for (int i = 0; i < w; i++) 
 		{
 			pv[i] *= 0.8f;
-			pv[grid_width + i] *= 0.8f;
-			pv[2 * grid_width + i] = pv[2 * grid_width + i] * 0.8f;
-			pv[(grid_height - 2) * grid_width + i] *= 0.8f;
-			pv[(grid_height - 1) * grid_width + i] *= 0.8f;
-
-			velocity[i] *= 0.9f;
-			velocity[grid_width + i] *= 0.9f;
-			velocity[(grid_height - 2) * grid_width + i] *= 0.9f;
-			velocity[(grid_height - 1) * grid_width + i] *= 0.9f;
+			pv[w + i] *= 0.8f;
+			pv[2 * w + i] = pv[2 * w + i] * 0.8f;
+			pv[(grid_height - 2) * w + i] *= 0.8f;
+			pv[(grid_height - 1) * w + i] *= 0.8f;
+			for (int x : { i, w + i, (grid_height - 2) * w + i, (grid_height - 1) * w + i })
+			{
+				vx[x] *= 0.9f;
+				vy[x] *= 0.9f;
+			}
+		}
+		// every stage only writes the rows of its band and
+		// the next one starts once all of them are done
+		run_tile_rows([this](int, int y0, int y1) { pressure_rows(y0, y1); });
+		run_tile_rows([this](int, int y0, int y1) { velocity_rows(y0, y1); });
+		// the heat is advected along in the same sweep
+		run_tile_rows([this](int worker, int y0, int y1) { advect_rows(worker, y0, y1); });
+		vx.swap(ovx);
+		vy.swap(ovy);
+		pv.swap(opv);
+	}
+	else if (ambient_heat)
+	{
+		run_tile_rows([this](int worker, int y0, int y1) { advect_heat_rows(worker, y0, y1); });
+	}
+	wake_cells();
+	if (ambient_heat)
+		hv.swap(ohv);
+	// the tiles that came to rest sleep until something wakes them
+	for (size_t tile = 0; tile < tile_running.size(); tile++)
+	{
+		if (!tile_running[tile])
+			continue;
+		if (!tile_moving[tile])
+			settle_tile(static_cast<int>(tile));
+		tile_active[tile].store(tile_moving[tile], std::memory_order_relaxed);
+		tile_moving[tile] = 0;
+	}
+}
+
+void Air::find_running_tiles()
+{
+	// a tile next to an active one can be pushed out of rest
+	std::fill(tile_running.begin(), tile_running.end(), 0);
+	for (int ty = 0; ty < tiles_y; ty++)
+	{
+		for (int tx = 0; tx < tiles_x; tx++)
+		{
+			if (!tile_active[ty * tiles_x + tx].load(std::memory_order_relaxed))
+				continue;
+			for (int y = std::max(ty - 1, 0); y <= std::min(ty + 1, tiles_y - 1); y++)
+				for (int x = std::max(tx - 1, 0); x <= std::min(tx + 1, tiles_x - 1); x++)
+					tile_running[y * tiles_x + x] = 1;
 		}
-		//pressure adjustments from velocity
-		for (int y = 1; y < grid_height; y++) 
+	}
+	for (int ty = 0; ty < tiles_y; ty++)
+	{
+		spans[ty].clear();
+		for (int tx = 0; tx < tiles_x; tx++)
 		{
-			for (int x = 1; x < grid_width; x++)
+			if (!tile_running[ty * tiles_x + tx])
+				continue;
+			int x1 = std::min((tx + 1) * AIR_TILE_SIZE, grid_width);
+			if (!spans[ty].empty() && spans[ty].back().second == tx * AIR_TILE_SIZE)
+				spans[ty].back().second = x1;
+			else
+				spans[ty].emplace_back(tx * AIR_TILE_SIZE, x1);
+		}
+	}
+}
+
+void Air::settle_tile(int tile)
+{
+	int x0 = (tile % tiles_x) * AIR_TILE_SIZE, y0 = (tile / tiles_x) * AIR_TILE_SIZE;
+	int x1 = std::min(x0 + AIR_TILE_SIZE, grid_width), y1 = std::min(y0 + AIR_TILE_SIZE, grid_height);
+	// both buffers, the skipped tiles are swapped along with the rest
+	for (int y = y0; y < y1; y++)
+	{
+		int row = y * grid_width;
+		if (air_mode != 0)
+		{
+			for (auto* field : { &vx, &vy, &pv, &ovx, &ovy, &opv })
+				std::fill(field->begin() + row + x0, field->begin() + row + x1, 0.0f);
+		}
+		if (ambient_heat)
+		{
+			std::fill(hv.begin() + row + x0, hv.begin() + row + x1, amb_air_temp);
+			std::fill(ohv.begin() + row + x0, ohv.begin() + row + x1, amb_air_temp);
+		}
+	}
+}
+
+void Air::wake_tile(int x, int y)
+{
+	tile_active[(y / AIR_TILE_SIZE) * tiles_x + x / AIR_TILE_SIZE].store(1, std::memory_order_relaxed);
+}
+
+void Air::set_solid(int x, int y, bool solid)
+{
+	int idx = x / cell_size + grid_width * (y / cell_size);
+	solid_count[idx] += solid ? 1 : -1;
+	uint64_t bit = 1ULL << (idx & 63);
+	if (solid_count[idx] * 2 > cell_size * cell_size)
+		obstacles[idx >> 6].fetch_or(bit, std::memory_order_relaxed);
+	else
+		obstacles[idx >> 6].fetch_and(~bit, std::memory_order_relaxed);
+	wake_tile(x / cell_size, y / cell_size);
+}
+
+void Air::wake_all()
+{
+	for (auto& active : tile_active)
+		active.store(1, std::memory_order_relaxed);
+}
+
+void Air::pressure_rows(int y0, int y1)
+{
+	int w = grid_width;
+	//pressure adjustments from velocity
+	simd_float ploss = simd_set(air_ploss), tstepp = simd_set(air_tstepp);
+	for (int y = std::max(y0, 1); y < y1; y++)
+	{
+		float* p = &pv[y * w];
+		const float* u = &vx[y * w];
+		const float* v = &vy[y * w];
+		const float* v_up = &vy[(y - 1) * w];
+		for (auto& span : spans[y / AIR_TILE_SIZE])
+		{
+			int x = std::max(span.first, 1);
+			for (; x + SIMD_WIDTH <= span.second; x += SIMD_WIDTH)
 			{
-				int idx = y * grid_width + x;
-				dp = 0.0f;
-				dp += velocity[idx - 1].x - velocity[idx].x;
-				dp += velocity[(y - 1) * grid_width + x].y - velocity[idx].y;
-				pv[idx] *= air_ploss;
-				pv[idx] += dp * air_tstepp;
+				simd_float dp = simd_add(simd_sub(simd_load(u + x - 1), simd_load(u + x)),
+					simd_sub(simd_load(v_up + x), simd_load(v + x)));
+				simd_store(p + x, simd_add(simd_mul(simd_load(p + x), ploss), simd_mul(dp, tstepp)));
+			}
+			for (; x < span.second; x++)
+			{
+				float dp = (u[x - 1] - u[x]) + (v_up[x] - v[x]);
+				p[x] = p[x] * air_ploss + dp * air_tstepp;
 			}
 		}
-		float dx = 0.0, dy = 0.0;
-		//velocity adjustments from pressure
-		for (int y = 0; y < grid_height - 1; y++) 
+	}
+}
+
+void Air::velocity_rows(int y0, int y1)
+{
+	int w = grid_width;
+	//velocity adjustments from pressure
+	simd_float vloss = simd_set(air_vloss), tstepv = simd_set(air_tstepv);
+	for (int y = y0; y < std::min(y1, grid_height - 1); y++)
+	{
+		const float* p = &pv[y * w];
+		const float* p_down = &pv[(y + 1) * w];
+		float* u = &vx[y * w];
+		float* v = &vy[y * w];
+		for (auto& span : spans[y / AIR_TILE_SIZE])
 		{
-			for (int x = 0; x < grid_width - 1; x++)
+			int x = span.first, x1 = std::min(span.second, w - 1);
+			for (; x + SIMD_WIDTH <= x1; x += SIMD_WIDTH)
 			{
-				int idx = y * grid_width + x;
-				dx = dy = 0.0;
-				dx += pv[idx] - pv[idx + 1];
-				dy += pv[idx] - pv[(y + 1) * grid_width + x];
-				velocity[idx] *= air_vloss;
-				velocity[idx].x += dx * air_tstepv;
-				velocity[idx].y += dy * air_tstepv;
+				simd_float here = simd_load(p + x);
+				simd_float dx = simd_sub(here, simd_load(p + x + 1));
+				simd_float dy = simd_sub(here, simd_load(p_down + x));
+				simd_store(u + x, simd_add(simd_mul(simd_load(u + x), vloss), simd_mul(dx, tstepv)));
+				simd_store(v + x, simd_add(simd_mul(simd_load(v + x), vloss), simd_mul(dy, tstepv)));
+			}
+			for (; x < x1; x++)
+			{
+				u[x] = u[x] * air_vloss + (p[x] - p[x + 1]) * air_tstepv;
+				v[x] = v[x] * air_vloss + (p[x] - p_down[x]) * air_tstepv;
 			}
 		}
-		float f = 0.0;
-		//update velocity and pressure
-		for (int y = 0; y < grid_height; y++) 
+	}
+}
+
+void Air::advect_rows(int worker, int y0, int y1)
+{
+	const float adv_dist_mult = 0.7f;
+	float stepX, stepY;
+	int stepLimit, step;
+	int w = grid_width;
+	bool heat = ambient_heat;
+	//update velocity and pressure
+	for (int y = y0; y < y1; y++)
+	{
+		// the blurred rows go straight to the output,
+		// the advection then works on them in place
+		float* out_x = &ovx[y * w];
+		float* out_y = &ovy[y * w];
+		float* out_p = &opv[y * w];
+		float* out_h = &ohv[y * w];
+		uint8_t* moving = &tile_moving[(y / AIR_TILE_SIZE) * tiles_x];
+		for (auto& span : spans[y / AIR_TILE_SIZE])
 		{
-			for (int x = 0; x < grid_width; x++)
+			blur_row(vx, out_x, y, span.first, span.second);
+			blur_row(vy, out_y, y, span.first, span.second);
+			blur_row(pv, out_p, y, span.first, span.second);
+			if (heat)
+				blur_row(hv, out_h, y, span.first, span.second);
+			for (int x = span.first; x < span.second; x++)
 			{
-				Vector d = Vector();
-				dp = 0.0f;
-				for (int j = -1; j < 2; j++)
-				{
-					for (int i = -1; i < 2; i++)
-					{
-						if (y + j > 0 && y + j < grid_height - 1 &&
-							x + i > 0 && x + i < grid_width - 1)
-						{
-							f = kernel[i + 1 + (j + 1) * 3];
-							d += velocity[(y + j) * grid_width + x + i] * f;
-							dp += pv[(y + j) * grid_width + x + i] * f;
-						}
-						else
-						{
-							f = kernel[i + 1 + (j + 1) * 3];
-							d += velocity[y * grid_width + x] * f;
-							dp += pv[y * grid_width + x] * f;
-						}
-					}
-				}
-				t = Vector(x, y) - d * adv_dist_mult;
-				if ((d.x * adv_dist_mult > 1.0f || d.y * adv_dist_mult > 1.0f) 
-					&& (t.x >= 2 && t.x < grid_width - 2 && t.y >= 2 && t.y < grid_height - 2))
+				float dx = out_x[x], dy = out_y[x], dp = out_p[x];
+				float tx = x - dx * adv_dist_mult;
+				float ty = y - dy * adv_dist_mult;
+				if ((dx * adv_dist_mult > 1.0f || dy * adv_dist_mult > 1.0f) 
+					&& (tx >= 2 && tx < w - 2 && ty >= 2 && ty < grid_height - 2))
 				{
 					// Trying to take velocity from far away, check whether there is an intervening wall. Step from current position to desired source location, looking for walls, with either the x or y step size being 1 cell
-					if (std::abs(d.x)>std::abs(d.y))
+					if (std::abs(dx) > std::abs(dy))
 					{
-						stepX = (d.x < 0.0f) ? 1 : -1;
-						stepY = -d.y / fabsf(d.x);
-						stepLimit = static_cast<int>(fabsf(d.x * adv_dist_mult));
+						stepX = (dx < 0.0f) ? 1 : -1;
+						stepY = -dy / fabsf(dx);
+						stepLimit = static_cast<int>(fabsf(dx * adv_dist_mult));
 					}
 					else
 					{
-						stepY = (d.y < 0.0f) ? 1 : -1;
-						stepX = -d.x / fabsf(d.y);
-						stepLimit = (int)(fabsf(d.y * adv_dist_mult));
+						stepY = (dy < 0.0f) ? 1 : -1;
+						stepX = -dx / fabsf(dy);
+						stepLimit = (int)(fabsf(dy * adv_dist_mult));
 					}
-					t.x = x;
-					t.y = y;
+					tx = static_cast<float>(x);
+					ty = static_cast<float>(y);
 					for (step = 0; step < stepLimit; ++step)
 					{
-						t.x += stepX;
-						t.y += stepY;
-						// CODE FOR WALLS IS OMMITED
+						tx += stepX;
+						ty += stepY;
+						if (is_obstacle(static_cast<int>(ty + 0.5f) * w + static_cast<int>(tx + 0.5f)))
+						{
+							// the air comes from the last cell before the wall
+							tx -= stepX;
+							ty -= stepY;
+							break;
+						}
 					}
 					if (step == stepLimit)
 					{
 						// No wall found
-						t.x = x - d.x * adv_dist_mult;
-						t.y = y - d.y * adv_dist_mult;
+						tx = x - dx * adv_dist_mult;
+						ty = y - dy * adv_dist_mult;
 					}
 				}
-				int i = static_cast<int>(t.x);
-				int j = static_cast<int>(t.y);
-				t -= Vector(i, j);
-				if (i >= 2 && i < grid_width - 2 &&
-					j >= 2 && j < grid_height - 2)
+				int i = static_cast<int>(tx);
+				int j = static_cast<int>(ty);
+				tx -= i;
+				ty -= j;
+				bool inside = i >= 2 && i < w - 2 && j >= 2 && j < grid_height - 2;
+				int src = j * w + i;
+				int idx = y * w + x;
+				// the heat follows the blurred velocity from the same spot
+				bool heat_moved = false;
+				if (heat)
 				{
-					d *= 1.0f - air_vadv;
-					d += air_vadv * (1.0f - t.x) * (1.0f - t.y) * velocity[j * grid_width + i];
-					d += air_vadv * t.x * (1.0f - t.y) * velocity[j * grid_width + i];
-					d += air_vadv * (1.0f - t.x) * t.y * velocity[(j + 1) * grid_width + i];
-					d += air_vadv * t.x * t.y * velocity[(j + 1) * grid_width + i + 1];
+					float dh = out_h[x];
+					if (inside)
+					{
+						dh *= 1.0f - air_vadv;
+						dh += air_vadv * (1.0f - tx) * (1.0f - ty) * hv[src];
+						dh += air_vadv * tx * (1.0f - ty) * hv[src + 1];
+						dh += air_vadv * (1.0f - tx) * ty * hv[src + w];
+						dh += air_vadv * tx * ty * hv[src + w + 1];
+					}
+					heat_moved = fabsf(dh - hv[idx]) > CHUNK_HEAT_EPS;
+					if (fabsf(dh - amb_air_temp) > AIR_REST_EPS)
+						moving[x / AIR_TILE_SIZE] = 1;
+					out_h[x] = dh;
+				}
+				if (inside)
+				{
+					float f00 = air_vadv * (1.0f - tx) * (1.0f - ty);
+					float f10 = air_vadv * tx * (1.0f - ty);
+					float f01 = air_vadv * (1.0f - tx) * ty;
+					float f11 = air_vadv * tx * ty;
+					dx *= 1.0f - air_vadv;
+					dy *= 1.0f - air_vadv;
+					dx += f00 * vx[src];
+					dy += f00 * vy[src];
+					dx += f10 * vx[src];
+					dy += f10 * vy[src];
+					dx += f01 * vx[src + w];
+					dy += f01 * vy[src + w];
+					dx += f11 * vx[src + w + 1];
+					dy += f11 * vy[src + w + 1];
 				}
 
 				// pressure/velocity caps
 				dp = std::clamp(dp, -256.0f, 256.0f);
-				d.x = std::clamp(d.x, -256.0f, 256.0f);
-				d.y = std::clamp(d.y, -256.0f, 256.0f);
+				dx = std::clamp(dx, -256.0f, 256.0f);
+				dy = std::clamp(dy, -256.0f, 256.0f);
+				// nothing flows inside of solids
+				if (is_obstacle(idx))
+					dx = dy = 0.0f;
 
 				switch (air_mode)
 				{
@@ -155,20 +408,25 @@ void Air::update_air()
 					dp = 0.0f;
 					break;
 				case 2:  // velocity off
-					d.Zero();
+					dx = dy = 0.0f;
 					break;
 				case 3: // air off
-					d.Zero();
+					dx = dy = 0.0f;
 					dp = 0.0f;
 					break;
 				}
 
-				ovelocity[y * grid_width + x] = d;
-				opv[y * grid_width + x] = dp;
+				// particles under moving air are pushed around
+				if (heat_moved || fabsf(dp - pv[idx]) > CHUNK_AIR_EPS
+					|| fabsf(dx) > CHUNK_AIR_EPS || fabsf(dy) > CHUNK_AIR_EPS)
+					wakes[worker].push_back(idx);
+				if (fabsf(dp) > AIR_REST_EPS || fabsf(dx) > AIR_REST_EPS || fabsf(dy) > AIR_REST_EPS)
+					moving[x / AIR_TILE_SIZE] = 1;
+				out_x[x] = dx;
+				out_y[x] = dy;
+				out_p[x] = dp;
 			}
 		}
-		velocity = ovelocity;
-		pv = opv;
 	}
 }
 
@@ -176,78 +434,112 @@ void Air::resize()
 {
 	grid_width = static_cast<int>(std::ceil(static_cast<float>(sim->cells_x_count) / cell_size));
 	grid_height = static_cast<int>(std::ceil(static_cast<float>(sim->cells_y_count) / cell_size));
-	velocity.assign(grid_width * grid_height, Vector());
-	ovelocity.assign(grid_width * grid_height, Vector());
-	hv.assign(grid_width * grid_height, 0.0);
-	ohv.assign(grid_width * grid_height, 0.0);
-	pv.assign(grid_width * grid_height, 0.0);
-	opv.assign(grid_width * grid_height, 0.0);
+	int size = grid_width * grid_height;
+	vx.assign(size, 0.0f);
+	vy.assign(size, 0.0f);
+	ovx.assign(size, 0.0f);
+	ovy.assign(size, 0.0f);
+	hv.assign(size, 0.0);
+	ohv.assign(size, 0.0);
+	pv.assign(size, 0.0);
+	opv.assign(size, 0.0);
+	blurred_vx.assign(get_thread_count() * grid_width, 0.0f);
+	blurred_vy.assign(get_thread_count() * grid_width, 0.0f);
+	tiles_x = (grid_width + AIR_TILE_SIZE - 1) / AIR_TILE_SIZE;
+	tiles_y = (grid_height + AIR_TILE_SIZE - 1) / AIR_TILE_SIZE;
+	tile_active = std::vector<std::atomic<uint8_t>>(tiles_x * tiles_y);
+	wake_all();
+	tile_running.assign(tiles_x * tiles_y, 0);
+	tile_moving.assign(tiles_x * tiles_y, 0);
+	spans.assign(tiles_y, {});
+	solid_count.assign(size, 0);
+	set_deposit_count(std::max(static_cast<int>(pressure_deposits.size()), 1));
+	obstacles = std::vector<std::atomic<uint64_t>>((size + 63) / 64);
+	for (auto& word : obstacles)
+		word.store(0, std::memory_order_relaxed);
 }
 
-void Air::update_airh()
+void Air::advect_heat_rows(int worker, int y0, int y1)
 {
-	float dh, f;
-	// TODO make the edges in the game one bit smaller then the air grid so this works properly
-	// or make them bigger but dont display all of it
-	for (int i = 0; i < grid_height; i++) //reduces pressure/velocity on the edges every frame
-	{
-		int idx = i * grid_width;
-		hv[idx] = amb_air_temp;
-		hv[idx + 1] = amb_air_temp;
-		hv[idx + grid_width - 2] = amb_air_temp;
-		hv[idx + grid_width - 2] = amb_air_temp;
-	}
-	for (int i = 0; i < grid_width; i++) //reduces pressure/velocity on the edges every frame
-	{
-		hv[i] = amb_air_temp;
-		hv[grid_width + i] = amb_air_temp;
-		hv[(grid_height - 2) * grid_width + i] = amb_air_temp;
-		hv[(grid_height - 1) * grid_width + i] = amb_air_temp;
-	}
-	for (int y = 0; y < grid_height; y++) //update velocity and pressure
+	int w = grid_width;
+	for (int y = y0; y < y1; y++)
 	{
-		for (int x = 0; x < grid_width; x++)
+		float* out_h = &ohv[y * w];
+		float* row_vx = &blurred_vx[worker * w];
+		float* row_vy = &blurred_vy[worker * w];
+		uint8_t* moving = &tile_moving[(y / AIR_TILE_SIZE) * tiles_x];
+		for (auto& span : spans[y / AIR_TILE_SIZE])
 		{
-			dh = 0.0f;
-			Vector d = Vector();
-			for (int j = -1; j < 2; j++)
+			blur_row(vx, row_vx, y, span.first, span.second);
+			blur_row(vy, row_vy, y, span.first, span.second);
+			blur_row(hv, out_h, y, span.first, span.second);
+			for (int x = span.first; x < span.second; x++)
 			{
-				for (int i = -1; i < 2; i++)
+				float dh = out_h[x];
+				float tx = x - row_vx[x] * 0.7f;
+				float ty = y - row_vy[x] * 0.7f;
+				int i = static_cast<int>(tx);
+				int j = static_cast<int>(ty);
+				tx -= i;
+				ty -= j;
+				if (i >= 2 && i < w - 2 && 
+					j >= 2 && j < grid_height - 2)
 				{
-					if (y + j > 0 && y + j < grid_height - 1 &&
-						x + i>0 && x + i < grid_width - 1)
-					{
-						f = kernel[i + 1 + (j + 1) * 3];
-						d += velocity[(y + j) * grid_width + x + i] * f;
-						dh += hv[(y + j) * grid_width + x + i] * f;
-					}
-					else
-					{
-						f = kernel[i + 1 + (j + 1) * 3];
-						d += velocity[y * grid_width + x] * f;
-						dh += hv[y * grid_width + x] * f;
-					}
+					int src = j * w + i;
+					dh *= 1.0f - air_vadv;
+					dh += air_vadv * (1.0f - tx) * (1.0f - ty) * hv[src];
+					dh += air_vadv * tx * (1.0f - ty) * hv[src + 1];
+					dh += air_vadv * (1.0f - tx) * ty * hv[src + w];
+					dh += air_vadv * tx * ty * hv[src + w + 1];
 				}
+				if (fabsf(dh - hv[y * w + x]) > CHUNK_HEAT_EPS)
+					wakes[worker].push_back(y * w + x);
+				if (fabsf(dh - amb_air_temp) > AIR_REST_EPS)
+					moving[x / AIR_TILE_SIZE] = 1;
+				out_h[x] = dh;
 			}
-			Vector t = Vector(x, y) - d * 0.7f;
-			int i = static_cast<int>(t.x);
-			int j = static_cast<int>(t.y);
-			t -= Vector(i, j);
-			if (i >= 2 && i < grid_width - 2 && 
-				j >= 2 && j < grid_height - 2)
-			{
-				dh *= 1.0f - air_vadv;
-				dh += air_vadv * (1.0f - t.x) * (1.0f - t.y) * hv[j * grid_width + i];
-				dh += air_vadv * t.x * (1.0f - t.y) * hv[j * grid_width + i + 1];
-				dh += air_vadv * (1.0f - t.x) * t.y * hv[(j + 1) * grid_width + i];
-				dh += air_vadv * t.x * t.y * hv[(j + 1) * grid_width + i + 1];
-			}
-			ohv[y * grid_width + x] = dh;
 		}
 	}
-	// add the code for the gravity later
-	// refactor
-	hv = ohv;
+}
+
+void Air::run_tile_rows(const std::function<void(int, int, int)>& job)
+{
+	workers.run(tiles_y, [this, &job](int ty)
+	{
+		if (!spans[ty].empty())
+			job(ThreadPool::worker, ty * AIR_TILE_SIZE, std::min((ty + 1) * AIR_TILE_SIZE, grid_height));
+	});
+}
+
+void Air::wake_cells()
+{
+	// the chunks are woken from this thread
+	for (auto& cells : wakes)
+	{
+		for (int idx : cells)
+			wake_cell(idx % grid_width, idx / grid_width);
+		cells.clear();
+	}
+}
+
+void Air::set_thread_count(int count)
+{
+	count = std::clamp(count, 1, 64);
+	workers.set_thread_count(count);
+	wakes.resize(count);
+	blurred_vx.assign(count * grid_width, 0.0f);
+	blurred_vy.assign(count * grid_width, 0.0f);
+}
+
+int Air::get_thread_count() const
+{
+	return workers.get_thread_count();
+}
+
+void Air::wake_cell(int x, int y)
+{
+	sim->chunks.wake_area(x * cell_size, y * cell_size,
+		(x + 1) * cell_size - 1, (y + 1) * cell_size - 1);
 }
 
 void Air::clear(std::vector<float>& data)
@@ -255,27 +547,102 @@ void Air::clear(std::vector<float>& data)
 	std::fill(data.begin(), data.end(), 0.0f);
 }
 
-void Air::clear(std::vector<Vector>& data)
+void Air::apply_deposits()
 {
-	for (auto& el : data)
+	float* pressure = pressure_deposits[0].data();
+	float* heat = heat_deposits[0].data();
+	// the tiles of the other workers are added to the ones of the first
+	std::vector<int>& tiles = deposit_tiles[0];
+	for (size_t w = 1; w < deposit_tiles.size(); w++)
 	{
-		el.Zero();
+		for (int tile : deposit_tiles[w])
+		{
+			if (!deposit_marks[0][tile])
+			{
+				deposit_marks[0][tile] = 1;
+				tiles.push_back(tile);
+			}
+		}
 	}
+	for (int tile : tiles)
+	{
+		int x0 = (tile % tiles_x) * AIR_TILE_SIZE, x1 = std::min(x0 + AIR_TILE_SIZE, grid_width);
+		int y0 = (tile / tiles_x) * AIR_TILE_SIZE, y1 = std::min(y0 + AIR_TILE_SIZE, grid_height);
+		// the other workers are summed into the first buffers
+		for (size_t w = 1; w < deposit_marks.size(); w++)
+		{
+			if (!deposit_marks[w][tile])
+				continue;
+			deposit_marks[w][tile] = 0;
+			float* other_pressure = pressure_deposits[w].data();
+			float* other_heat = heat_deposits[w].data();
+			for (int y = y0; y < y1; y++)
+			{
+				int row_start = y * grid_width + x0, row_end = y * grid_width + x1;
+				int i = row_start;
+				for (; i + SIMD_WIDTH <= row_end; i += SIMD_WIDTH)
+				{
+					simd_store(pressure + i, simd_add(simd_load(pressure + i), simd_load(other_pressure + i)));
+					simd_store(heat + i, simd_add(simd_load(heat + i), simd_load(other_heat + i)));
+				}
+				for (; i < row_end; i++)
+				{
+					pressure[i] += other_pressure[i];
+					heat[i] += other_heat[i];
+				}
+				std::fill(other_pressure + row_start, other_pressure + row_end, 0.0f);
+				std::fill(other_heat + row_start, other_heat + row_end, 0.0f);
+			}
+		}
+		deposit_marks[0][tile] = 0;
+		bool changed = false;
+		for (int y = y0; y < y1; y++)
+		{
+			for (int i = y * grid_width + x0; i < y * grid_width + x1; i++)
+			{
+				if (pressure[i] == 0 && heat[i] == 0)
+					continue;
+				pv[i] += pressure[i];
+				hv[i] = std::clamp(hv[i] + heat[i] / air_shc, 0.0f, 10000.0f);
+				pressure[i] = 0;
+				heat[i] = 0;
+				changed = true;
+			}
+		}
+		if (changed)
+			tile_active[tile].store(1, std::memory_order_relaxed);
+	}
+	for (auto& list : deposit_tiles)
+		list.clear();
+}
+
+void Air::set_deposit_count(int count)
+{
+	int size = grid_width * grid_height;
+	pressure_deposits.assign(count, std::vector<float>(size, 0.0f));
+	heat_deposits.assign(count, std::vector<float>(size, 0.0f));
+	deposit_tiles.assign(count, {});
+	deposit_marks.assign(count, std::vector<uint8_t>(tiles_x * tiles_y, 0));
 }
 
 void Air::add_pressure(int x, int y, float pressure)
 {
 	pv[x / cell_size + grid_width * (y / cell_size)] += pressure;
+	wake_tile(x / cell_size, y / cell_size);
 }
 
 void Air::add_velocity(int x, int y, Vector vel)
 {
-	velocity[x / cell_size + grid_width * (y / cell_size)] += vel;
+	int idx = x / cell_size + grid_width * (y / cell_size);
+	vx[idx] += vel.x;
+	vy[idx] += vel.y;
+	wake_tile(x / cell_size, y / cell_size);
 }
 
 void Air::add_heat(int x, int y, float heat)
 {
 	int idx = x / cell_size + grid_width * (y / cell_size);
+	wake_tile(x / cell_size, y / cell_size);
 	hv[idx] += (heat / air_shc);
 	hv[idx] = std::clamp(hv[idx], 0.0f, 10000.0f);
 }
@@ -292,7 +659,17 @@ float Air::get_temperature(int x, int y)
 
 Vector Air::get_force(int x, int y)
 {
-	return velocity[x / cell_size + grid_width * (y / cell_size)];
+	int idx = x / cell_size + grid_width * (y / cell_size);
+	return Vector(vx[idx], vy[idx]);
+}
+
+std::vector<Vector> Air::get_velocities() const
+{
+	std::vector<Vector> velocities;
+	velocities.reserve(vx.size());
+	for (size_t i = 0; i < vx.size(); i++)
+		velocities.emplace_back(vx[i], vy[i]);
+	return velocities;
 }
 
 Air::Air(Simulation* sim, int air_mode, float ambient_air_temp, int cell_size) :
@@ -302,21 +679,13 @@ Air::Air(Simulation* sim, int air_mode, float ambient_air_temp, int cell_size) :
 	cell_size(cell_size),
 	ambient_heat(false),
 	grid_width(static_cast<int>(std::ceil(static_cast<float>(sim->cells_x_count) / cell_size))),
-	grid_height(static_cast<int>(std::ceil(static_cast<float>(sim->cells_y_count) / cell_size)))
+	grid_height(static_cast<int>(std::ceil(static_cast<float>(sim->cells_y_count) / cell_size))),
+	workers(1)
 {
 	make_kernel();
-	for (int i = 0; i < grid_height; i++)
-	{
-		for (int j = 0; j < grid_width; j++)
-		{
-			velocity.emplace_back(Vector());
-			ovelocity.emplace_back(Vector());
-			hv.push_back(amb_air_temp);
-			ohv.push_back(0.0);
-			pv.push_back(0.0);
-			opv.push_back(0.0);
-		}
-	}
+	resize();
+	std::fill(hv.begin(), hv.end(), amb_air_temp);
+	set_thread_count(static_cast<int>(std::thread::hardware_concurrency()));
 }
 
 
@@ -1,11 +1,23 @@
 #pragma once
 #include <vector>
+#include <algorithm>
+#include <functional>
+#include <atomic>
+#include <stdint.h>
 #include "Utils/Vector.h"
+#include "Utils/ThreadPool.h"
 
 
 
 class Simulation;
 
+// Air cells per side of a tile, tiles at rest are skipped
+#define AIR_TILE_SHIFT 4
+#define AIR_TILE_SIZE (1 << AIR_TILE_SHIFT)
+// Largest pressure, velocity and distance from the ambient
+// temperature of a cell at rest
+#define AIR_REST_EPS 0.0001f
+
 // The main algorithm and idea are adapted from
 // the powder toys source code
 // https://github.com/ThePowderToy/The-Powder-Toy/blob/master/src/simulation/Air.cpp
@@ -27,29 +39,117 @@ public:
 	float air_vloss = 0.999f;
 	float air_ploss = 0.9999f;
 
-	std::vector<Vector> velocity;
+	// Velocity of the air split into its components,
+	// so the kernels can run over whole rows
+	std::vector<float> vx, vy;
 	std::vector<float> pv;
 	std::vector<float> hv;
 
-	void update_airh();
-	void update_air();
+	// Advances the pressure and the velocity,
+	// and the temperature with ambient_heat on
+	void update();
 	void resize();
 	void clear(std::vector<float>& data);
-	void clear(std::vector<Vector>& data);
 	void add_pressure(int x, int y, float pressure);
 	void add_velocity(int x, int y, Vector vel);
 	void add_heat(int x, int y, float heat);
 	float get_pressure(int x, int y);
 	float get_temperature(int x, int y);
+	// Pressure and heat given by the particles to the air cell x, y
+	// during a tick, kept per worker of the simulation. The fields
+	// don't change until apply_deposits, so every particle samples the same air
+	void deposit_pressure(int x, int y, float pressure)
+	{
+		int worker = std::max(ThreadPool::worker, 0);
+		pressure_deposits[worker][x + grid_width * y] += pressure;
+		mark_deposit(worker, x, y);
+	}
+	void deposit_heat(int x, int y, float heat)
+	{
+		int worker = std::max(ThreadPool::worker, 0);
+		heat_deposits[worker][x + grid_width * y] += heat;
+		mark_deposit(worker, x, y);
+	}
+	// Adds up the deposits into the fields, once the particles are done
+	void apply_deposits();
+	// Deposit buffers, one per worker of the simulation
+	void set_deposit_count(int count);
 	Vector get_force(int x, int y);
+	// The velocity of every cell, for drawing
+	std::vector<Vector> get_velocities() const;
+	// Threads the tiles are split over, in rows of tiles
+	void set_thread_count(int count);
+	int get_thread_count() const;
+	// Updates every tile again, for when the settings change
+	void wake_all();
+	// The particle in cell x, y became solid or stopped being solid,
+	// air cells that are mostly solid block the air
+	void set_solid(int x, int y, bool solid);
 	Air(Simulation* sim, int air_mode, float ambient_air_temp, int cell_size);
 	~Air();
 private:
 	float kernel[9];
-	std::vector<Vector> ovelocity;
+	// Written by the updates and then swapped with the fields
+	std::vector<float> ovx, ovy;
 	std::vector<float> opv;
 	std::vector<float> ohv;
+	// Blurred velocity of the row every worker is on, used by advect_heat_rows
+	std::vector<float> blurred_vx, blurred_vy;
+	ThreadPool workers;
+	// Air cells whose particles have to be woken, found by every worker
+	std::vector<std::vector<int>> wakes;
+	std::vector<std::vector<float>> pressure_deposits, heat_deposits;
+	// The tiles every worker deposited into during the tick,
+	// only those are added up and cleared by apply_deposits
+	std::vector<std::vector<int>> deposit_tiles;
+	std::vector<std::vector<uint8_t>> deposit_marks;
+	int tiles_x, tiles_y;
+	// Tiles away from rest or written to, the particles
+	// write to them from several threads
+	std::vector<std::atomic<uint8_t>> tile_active;
+	// Tiles updated during this tick, the active ones and their neighbours
+	std::vector<uint8_t> tile_running;
+	// Running tiles with a cell away from rest after the update
+	std::vector<uint8_t> tile_moving;
+	// The running tiles of every row of tiles merged into spans of cells
+	std::vector<std::vector<std::pair<int, int>>> spans;
+	// Solid particles in every air cell
+	std::vector<uint16_t> solid_count;
+	// Air cells blocking the air, 64 to a word. A word covers the air
+	// cells of several chunks so it's changed atomically
+	std::vector<std::atomic<uint64_t>> obstacles;
+	bool is_obstacle(int idx) const
+	{
+		return (obstacles[idx >> 6].load(std::memory_order_relaxed) >> (idx & 63)) & 1;
+	}
+	void mark_deposit(int worker, int x, int y)
+	{
+		int tile = (y >> AIR_TILE_SHIFT) * tiles_x + (x >> AIR_TILE_SHIFT);
+		if (!deposit_marks[worker][tile])
+		{
+			deposit_marks[worker][tile] = 1;
+			deposit_tiles[worker].push_back(tile);
+		}
+	}
 	//gaussian blur kernel
 	void make_kernel();
+	// Blurs the cells x0 to x1 of row y of the field into out
+	void blur_row(const std::vector<float>& data, float* out, int y, int x0, int x1) const;
+	// Wakes the particles covered by the air cell
+	void wake_cell(int x, int y);
+	void wake_cells();
+	void wake_tile(int x, int y);
+	void find_running_tiles();
+	// Puts the tile exactly at rest
+	void settle_tile(int tile);
+	// Calls job(worker, y0, y1) with the rows y0 to y1 of
+	// every row of tiles that has running tiles
+	void run_tile_rows(const std::function<void(int, int, int)>& job);
+	// The stages of update over the running tiles of the rows y0 to y1,
+	// advect_rows takes the heat along, advect_heat_rows is for heat alone
+	void pressure_rows(int y0, int y1);
+	void velocity_rows(int y0, int y1);
+	void advect_rows(int worker, int y0, int y1);
+	void advect_heat_rows(int worker, int y0, int y1);
 };
 
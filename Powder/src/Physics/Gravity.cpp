@@ -20,6 +20,15 @@ void Gravity::resize()
 		(std::ceil(static_cast<float>(sim->cells_y_count) / cell_size));
 	mass_grid.assign(grid_height * grid_width, 0);
 	grav_grid.assign(grid_height * grid_width, base_grav);
+	active_cells.clear();
+	active_slot.assign(grid_height * grid_width, -1);
+	dirty_cells.clear();
+	dirty.assign(grid_height * grid_width, 0);
+	wait_worker();
+	work.assign(grid_height * grid_width, Vector(0, 0));
+	field_mass.assign(grid_height * grid_width, 0);
+	ready.assign(grid_height * grid_width, Vector(0, 0));
+	has_result = false;
 }
 
 void Gravity::set_baseG()
@@ -28,84 +37,303 @@ void Gravity::set_baseG()
 	base_grav *= base_g;
 }
 
-void Gravity::set_mass_th(float old_th)
+void Gravity::set_mass_th()
 {
-	active_cells.remove_if([this](int idx) -> bool {
-		return fabs(mass_grid[idx]) < mass_th;
-	});
 	for (size_t i = 0; i < mass_grid.size(); i++)
-		if (fabs(mass_grid[i]) < old_th &&
-			fabs(mass_grid[i]) >= mass_th)
-			active_cells.push_back(i);
+		set_active(static_cast<int>(i), fabs(mass_grid[i]) >= mass_th);
 	changed = true;
 }
 
-void Gravity::update_mass(float mass, int new_x, int new_y, int old_x, int old_y)
+void Gravity::set_active(int idx, bool active)
 {
-	int n_id = new_x / cell_size + grid_width * (new_y / cell_size);
-	int o_id = old_x / cell_size + grid_width * (old_y / cell_size);
-	if (n_id == o_id)
-	{
+	if (active == (active_slot[idx] != -1))
 		return;
+	if (active)
+	{
+		active_slot[idx] = static_cast<int>(active_cells.size());
+		active_cells.push_back(idx);
 	}
-	float old_mass;
-	if (new_x != -1 && new_y != -1)
+	else
+	{
+		// the last cell takes its place
+		int last = active_cells.back();
+		active_cells[active_slot[idx]] = last;
+		active_slot[last] = active_slot[idx];
+		active_cells.pop_back();
+		active_slot[idx] = -1;
+	}
+}
+
+void Gravity::mark_dirty(int idx)
+{
+	if (!dirty[idx])
 	{
-		old_mass = mass_grid[n_id];
-		mass_grid[n_id] += mass;
-		if (fabs(old_mass) < mass_th &&
-			fabs(mass_grid[n_id]) >= mass_th)
+		dirty[idx] = 1;
+		dirty_cells.push_back(idx);
+	}
+}
+
+float Gravity::pulling_mass(int idx) const
+{
+	return active_slot[idx] != -1 ? mass_grid[idx] : 0.0f;
+}
+
+void Gravity::deposit_mass()
+{
+	const ParticleStore& ps = sim->particles;
+	deposit.assign(mass_grid.size(), 0.0f);
+	// a gravity cell at a time, no division per particle
+	for (int y = 0; y < sim->cells_y_count; y++)
+	{
+		const int* row = &sim->elements_grid[y * sim->cells_x_count];
+		float* cells = &deposit[(y / cell_size) * grid_width];
+		for (int gx = 0; gx < grid_width; gx++)
 		{
-			active_cells.push_back(n_id);
-			changed = true;
+			int x1 = std::min((gx + 1) * cell_size, sim->cells_x_count);
+			for (int x = gx * cell_size; x < x1; x++)
+				if (row[x] != PT_NONE)
+					cells[gx] += ps.mass[row[x]];
 		}
 	}
-	if (old_x != -1 && old_y != -1)
+	for (size_t i = 0; i < mass_grid.size(); i++)
 	{
-		old_mass = mass_grid[o_id];
-		mass_grid[o_id] -= mass;
-		if (fabs(old_mass) >= mass_th &&
-			fabs(mass_grid[o_id]) < mass_th)
+		if (deposit[i] == mass_grid[i])
+			continue;
+		float old_mass = mass_grid[i];
+		mass_grid[i] = deposit[i];
+		bool active = fabs(mass_grid[i]) >= mass_th;
+		// cells under the threshold don't pull
+		if (active || fabs(old_mass) >= mass_th)
 		{
-			active_cells.remove(o_id);
-			changed = true;
+			set_active(static_cast<int>(i), active);
+			mark_dirty(static_cast<int>(i));
 		}
 	}
 }
 
-void Gravity::update_grav()
+bool Gravity::update_grav()
+{
+	if (!async)
+		wait_worker();
+	bool crossed = false;
+	{
+		std::lock_guard<std::mutex> lock(job_mutex);
+		if (busy)
+			return false;
+	}
+	// the field the worker finished since the last tick
+	if (has_result)
+	{
+		grav_grid.swap(ready);
+		crossed = ready_crossed;
+		has_result = false;
+	}
+	if (!changed && dirty_cells.empty())
+		return crossed;
+	prepare_job();
+	if (!async)
+	{
+		crossed |= run_job();
+		grav_grid = work;
+		return crossed;
+	}
+	if (!worker.joinable())
+		worker = std::thread(&Gravity::worker_loop, this);
+	{
+		std::lock_guard<std::mutex> lock(job_mutex);
+		busy = true;
+		has_result = true;
+	}
+	job_cv.notify_all();
+	return crossed;
+}
+
+void Gravity::prepare_job()
 {
-	if (changed)
+	job.solver = solver;
+	job.dist = dist_th;
+	job.cell_size = cell_size;
+	job.width = grid_width;
+	job.height = grid_height;
+	job.empty = active_cells.empty();
+	// past a point putting the field together again is cheaper
+	// than moving the pull of every dirty cell
+	job.rebuild = changed;
+	if (!changed && solver == GRAV_SOLVER_FFT)
+		job.rebuild = dirty_cells.size() * GRAV_FFT_DELTA_RATIO
+			> static_cast<size_t>(FFT::size_for(grid_width + dist_th)) * FFT::size_for(grid_height + dist_th);
+	else if (!changed)
+		job.rebuild = dirty_cells.size() >= active_cells.size();
+	job.cells.clear();
+	job.masses.clear();
+	const std::vector<int>& cells = job.rebuild ? active_cells : dirty_cells;
+	for (int idx : cells)
 	{
-		clear_field();
-		// o stands for orignal, n new
-		int oX, oY, nX, nY;
-		for (int el : active_cells)
+		job.cells.push_back(idx);
+		job.masses.push_back(pulling_mass(idx));
+	}
+	for (int idx : dirty_cells)
+		dirty[idx] = 0;
+	dirty_cells.clear();
+	changed = false;
+}
+
+bool Gravity::run_job()
+{
+	prepare_pull();
+	if (job.rebuild)
+	{
+		std::fill(field_mass.begin(), field_mass.end(), 0.0f);
+		if (job.solver == GRAV_SOLVER_FFT)
+		{
+			update_grav_fft();
+		}
+		else
 		{
-			oX = el % grid_width;
-			oY = el / grid_width;
-			for (int i = -dist_th; i <= dist_th; i++)
-			{
-				for (int j = -dist_th; j <= dist_th; j++)
-				{
-					int distance_sq = i * i + j * j;
-					if ((i != 0 || j != 0) && distance_sq <= dist_th * dist_th)
-					{
-						nX = oX + j;
-						nY = oY + i;
-						if (nX < 0 || nX >= grid_width || nY < 0 || nY >= grid_height)
-							continue;
-						int other_cell_index = nX + nY * grid_width;
-						float distance_sqf = static_cast<float>(distance_sq);
-						// we multiply by cell_size because  distance is the distance between
-						// the gravavity cells not the simulation cells
-						grav_grid[other_cell_index] += Vector(oX - nX, oY - nY) * mass_grid[el] /
-							(distance_sqf * sqrtf(distance_sqf) * static_cast<float>(cell_size * cell_size * cell_size));
-					}
-				}
-			}
+			std::fill(work.begin(), work.end(), Vector(0, 0));
+			for (size_t i = 0; i < job.cells.size(); i++)
+				add_pull(job.cells[i], job.masses[i]);
+		}
+		for (size_t i = 0; i < job.cells.size(); i++)
+			field_mass[job.cells[i]] = job.masses[i];
+		return true;
+	}
+	bool crossed = false;
+	for (size_t i = 0; i < job.cells.size(); i++)
+	{
+		int idx = job.cells[i];
+		float mass = job.masses[i];
+		crossed |= (mass == 0) != (field_mass[idx] == 0);
+		if (mass != field_mass[idx])
+			add_pull(idx, mass - field_mass[idx]);
+		field_mass[idx] = mass;
+	}
+	// nothing pulls anymore, the rounding errors left behind are dropped
+	if (crossed && job.empty)
+		std::fill(work.begin(), work.end(), Vector(0, 0));
+	return crossed;
+}
+
+void Gravity::worker_loop()
+{
+	std::unique_lock<std::mutex> lock(job_mutex);
+	while (true)
+	{
+		job_cv.wait(lock, [this] { return busy || stopping; });
+		if (stopping)
+			return;
+		lock.unlock();
+		bool crossed = run_job();
+		ready = work;
+		lock.lock();
+		ready_crossed = crossed;
+		busy = false;
+		job_cv.notify_all();
+	}
+}
+
+void Gravity::wait_worker()
+{
+	std::unique_lock<std::mutex> lock(job_mutex);
+	job_cv.wait(lock, [this] { return !busy; });
+}
+
+void Gravity::add_pull(int idx, float mass)
+{
+	int width = job.width, height = job.height, dist = job.dist;
+	int oX = idx % width, oY = idx / width;
+	int span = 2 * dist + 1;
+	int i0 = std::max(-dist, -oY), i1 = std::min(dist, height - 1 - oY);
+	for (int i = i0; i <= i1; i++)
+	{
+		int reach = pull_reach[i + dist];
+		int j0 = std::max(-reach, -oX), j1 = std::min(reach, width - 1 - oX);
+		const Vector* row = &pull[(i + dist) * span + dist];
+		Vector* out = &work[(oY + i) * width + oX];
+		for (int j = j0; j <= j1; j++)
+		{
+			out[j].x += row[j].x * mass;
+			out[j].y += row[j].y * mass;
+		}
+	}
+}
+
+void Gravity::update_grav_fft()
+{
+	prepare_kernel();
+	// only the active cells pull, same as with the direct sum
+	spectrum.assign(fft_width * fft_height, 0.0f);
+	for (size_t i = 0; i < job.cells.size(); i++)
+		spectrum[(job.cells[i] / job.width) * fft_width + job.cells[i] % job.width] = job.masses[i];
+	fft.transform_2d(spectrum, fft_width, fft_height, false);
+	for (size_t i = 0; i < spectrum.size(); i++)
+		spectrum[i] = FFT::multiply(spectrum[i], kernel_spectrum[i]);
+	fft.transform_2d(spectrum, fft_width, fft_height, true);
+	// the kernel is real in both parts, so the x and
+	// y forces come back as the real and imaginary values
+	for (int y = 0; y < job.height; y++)
+		for (int x = 0; x < job.width; x++)
+		{
+			std::complex<float> force = spectrum[y * fft_width + x];
+			work[y * job.width + x] = Vector(force.real(), force.imag());
+		}
+}
+
+void Gravity::prepare_kernel()
+{
+	if (kernel_width == job.width && kernel_height == job.height
+		&& kernel_dist == job.dist && kernel_cell_size == job.cell_size)
+		return;
+	kernel_width = job.width;
+	kernel_height = job.height;
+	kernel_dist = job.dist;
+	kernel_cell_size = job.cell_size;
+	int dist = job.dist;
+	// nothing further than dist_th may reach around the edges
+	fft_width = FFT::size_for(job.width + dist);
+	fft_height = FFT::size_for(job.height + dist);
+	kernel_spectrum.assign(fft_width * fft_height, 0.0f);
+	int span = 2 * dist + 1;
+	for (int i = -dist; i <= dist; i++)
+	{
+		for (int j = -dist; j <= dist; j++)
+		{
+			const Vector& f = pull[(i + dist) * span + j + dist];
+			int x = (j + fft_width) % fft_width, y = (i + fft_height) % fft_height;
+			kernel_spectrum[y * fft_width + x] = std::complex<float>(f.x, f.y);
+		}
+	}
+	fft.transform_2d(kernel_spectrum, fft_width, fft_height, false);
+}
+
+void Gravity::prepare_pull()
+{
+	if (pull_dist == job.dist && pull_cell_size == job.cell_size)
+		return;
+	pull_dist = job.dist;
+	pull_cell_size = job.cell_size;
+	int dist = job.dist, cell_size = job.cell_size;
+	// the kernel has to be built again from the table
+	kernel_width = 0;
+	int span = 2 * dist + 1;
+	pull.assign(span * span, Vector(0, 0));
+	pull_reach.assign(span, 0);
+	for (int i = -dist; i <= dist; i++)
+	{
+		for (int j = -dist; j <= dist; j++)
+		{
+			int distance_sq = i * i + j * j;
+			if (distance_sq > dist * dist)
+				continue;
+			pull_reach[i + dist] = std::max(pull_reach[i + dist], j);
+			if (i == 0 && j == 0)
+				continue;
+			float distance_sqf = static_cast<float>(distance_sq);
+			// we multiply by cell_size because  distance is the distance between
+			// the gravavity cells not the simulation cells
+			float div = distance_sqf * sqrtf(distance_sqf) * static_cast<float>(cell_size * cell_size * cell_size);
+			pull[(i + dist) * span + j + dist] = Vector(-j / div, -i / div);
 		}
-		changed = false;
 	}
 }
 
@@ -126,8 +354,12 @@ Gravity::Gravity(Simulation* sim, float mass_threshold, int distance_threshold,
 	sim(sim),
 	grid_width(static_cast<int>(std::ceil(static_cast<float>(sim->cells_x_count) / cell_size))),
 	grid_height(static_cast<int>(std::ceil(static_cast<float>(sim->cells_y_count) / cell_size))),
-	mass_grid(grid_height * grid_width, 0)
-
+	mass_grid(grid_height * grid_width, 0),
+	active_slot(grid_height * grid_width, -1),
+	dirty(grid_height * grid_width, 0),
+	work(grid_height * grid_width, Vector(0, 0)),
+	field_mass(grid_height * grid_width, 0),
+	ready(grid_height * grid_width, Vector(0, 0))
 {
 	base_grav = Vector(0, 1) * base_g;
 	for (int i = 0; i < grid_height; i++)
@@ -141,4 +373,11 @@ Gravity::Gravity(Simulation* sim, float mass_threshold, int distance_threshold,
 
 Gravity::~Gravity()
 {
+	{
+		std::lock_guard<std::mutex> lock(job_mutex);
+		stopping = true;
+	}
+	job_cv.notify_all();
+	if (worker.joinable())
+		worker.join();
 }
\ No newline at end of file
@@ -1,10 +1,40 @@
 #pragma once
 #include <vector>
-#include <list>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <stdint.h>
+#include <complex>
 #include "Utils/Vector.h"
+#include "Utils/FFT.h"
+
+// Ways update_grav can compute the field
+// Sums the pull of every active cell on the cells around it
+#define GRAV_SOLVER_DIRECT 0
+// Convolves the active masses with the pull of a unit mass
+// through FFTs, the cost doesn't depend on the active cells
+#define GRAV_SOLVER_FFT 1
+// Between two updates, pulls of more cells than the padded grid
+// holds divided by this are put in from scratch with the FFTs
+#define GRAV_FFT_DELTA_RATIO 32
 
 class Simulation;
 
+// What a field is computed from, copied out of the masses so
+// the worker thread doesn't share anything with the particles
+struct GravityJob
+{
+	// Whether the field is put together from scratch out of the cells,
+	// otherwise they are the ones that changed since the last job
+	bool rebuild = false;
+	// Whether no cell pulls anymore
+	bool empty = false;
+	int solver = GRAV_SOLVER_FFT;
+	int dist = 0, cell_size = 0, width = 0, height = 0;
+	std::vector<int> cells;
+	std::vector<float> masses;
+};
+
 class Gravity
 {
 public:
@@ -13,23 +43,94 @@ public:
 	float G;
 	float mass_th;
 	float base_g;
+	// Set when the whole field has to be computed again,
+	// mass moving around only updates the cells it changed
 	bool changed;
 	int dist_th;
 	int cell_size;
 	int grid_width;
 	int grid_height;
+	int solver = GRAV_SOLVER_FFT;
+	// Computes the field on a thread of its own so the ticks never wait
+	// for it, the particles feel it a tick or two late. Off, the field
+	// is computed during the tick and the runs can be reproduced
+	bool async = true;
 	Vector base_grav;
 	std::vector<Vector> grav_grid;
 	std::vector<float> mass_grid;
-	std::list<int> active_cells;
+	// Cells whose mass is over the threshold, in no particular order
+	std::vector<int> active_cells;
 	void clear_field();
 	void resize();
 	void set_baseG();
-	void set_mass_th(float old_th);
-	void update_mass(float mass, int new_x, int new_y, int old_x, int old_y);
-	void update_grav();
+	void set_mass_th();
+	// Sums the mass of the particles in every cell, once per tick
+	// after they moved. Cells whose mass changed get their pull updated
+	void deposit_mass();
+	// Brings the field up to date with the masses, or hands them to the
+	// worker and puts in the last field it finished. False if no cell
+	// started or stopped pulling in the field since the last time
+	bool update_grav();
 	Vector get_force(int x, int y, float mass);
 	Gravity(Simulation* sim, float mass_threshold, int distance_threshold, int cell_size, float base_g, float g);
 	~Gravity();
+private:
+	// Position of every cell in active_cells, -1 if it isn't in it
+	std::vector<int> active_slot;
+	// Cells whose pull changed since the last update
+	std::vector<int> dirty_cells;
+	std::vector<uint8_t> dirty;
+	// Everything below is only touched by whoever runs the job,
+	// the worker or the main thread while the worker is idle
+	GravityJob job;
+	// The field the jobs update, the particles read a copy of it
+	std::vector<Vector> work;
+	// Mass every cell currently pulls with in work
+	std::vector<float> field_mass;
+	// Last field the worker finished, swapped with grav_grid
+	std::vector<Vector> ready;
+	bool ready_crossed = false;
+	// Whether ready holds a field grav_grid hasn't got yet
+	bool has_result = false;
+	std::thread worker;
+	std::mutex job_mutex;
+	std::condition_variable job_cv;
+	// Set while the worker runs the job
+	bool busy = false;
+	bool stopping = false;
+	// Pull of a unit mass on the cells up to dist_th away, rows
+	// of 2 * dist_th + 1 cells with the mass in the middle one.
+	// pull_reach is how far the circle goes on every row
+	std::vector<Vector> pull;
+	std::vector<int> pull_reach;
+	int pull_dist = 0, pull_cell_size = 0;
+	FFT fft;
+	// Size of the padded grid the FFTs work on, big enough
+	// that the pull doesn't wrap around the edges
+	int fft_width = 0, fft_height = 0;
+	// Transform of the pull of a unit mass, the x part in the real
+	// and the y part in the imaginary values. Kept until the grid,
+	// the cell size or the distance threshold change
+	std::vector<std::complex<float>> kernel_spectrum;
+	int kernel_width = 0, kernel_height = 0, kernel_dist = 0, kernel_cell_size = 0;
+	std::vector<std::complex<float>> spectrum;
+	void set_active(int idx, bool active);
+	void mark_dirty(int idx);
+	// Mass of the cells being summed by deposit_mass
+	std::vector<float> deposit;
+	// Mass of the cell the field should hold
+	float pulling_mass(int idx) const;
+	// Copies the masses into the job
+	void prepare_job();
+	// Updates work from the job, true if a cell
+	// started or stopped pulling
+	bool run_job();
+	void worker_loop();
+	void wait_worker();
+	// Adds the pull of mass in the cell to work
+	void add_pull(int idx, float mass);
+	void update_grav_fft();
+	void prepare_pull();
+	void prepare_kernel();
 };
 
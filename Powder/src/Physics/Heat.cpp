@@ -0,0 +1,194 @@
+#include "Heat.h"
+#include "Simulation.h"
+#include "Utils/Simd.h"
+
+void Heat::update()
+{
+	const ChunkGrid& chunks = sim->chunks;
+	int bands = chunks.height;
+	band_active.assign(bands, 0);
+	bool any = false;
+	for (int cy = 0; cy < bands; cy++)
+	{
+		for (int cx = 0; cx < chunks.width; cx++)
+		{
+			if (!chunks.chunks[cy * chunks.width + cx].active.empty())
+			{
+				for (int band = std::max(cy - 1, 0); band <= std::min(cy + 1, bands - 1); band++)
+					band_active[band] = 1;
+				any = true;
+				break;
+			}
+		}
+	}
+	if (!any)
+		return;
+	auto run = [this, bands](void (Heat::*rows_job)(int, int), bool all)
+	{
+		sim->workers.run(bands, [this, rows_job, all](int band)
+		{
+			if (all || band_active[band])
+				(this->*rows_job)(band * CHUNK_SIZE, std::min((band + 1) * CHUNK_SIZE, sim->cells_y_count));
+		});
+	};
+	// every band reads the rows around it, so each step
+	// is done everywhere before the next one starts
+	run(&Heat::gather_rows, true);
+	if (implicit)
+	{
+		iterations = std::clamp(iterations, 1, 64);
+		for (int i = 0; i < iterations; i++)
+		{
+			if (i > 0)
+				guess.swap(next);
+			run(&Heat::solve_rows, false);
+		}
+	}
+	else
+	{
+		run(&Heat::conduct_rows, false);
+	}
+	run(&Heat::scatter_rows, false);
+}
+
+void Heat::gather_rows(int y0, int y1)
+{
+	const ParticleStore& ps = sim->particles;
+	if (!band_active[y0 >> CHUNK_SIZE_LOG2])
+	{
+		std::fill(occupied.begin() + (y0 + 1) * stride, occupied.begin() + (y1 + 1) * stride, 0.0f);
+		return;
+	}
+	for (int y = y0; y < y1; y++)
+	{
+		const int* grid = &sim->elements_grid[y * sim->cells_x_count];
+		int row = (y + 1) * stride + 1;
+		for (int x = 0; x < sim->cells_x_count; x++)
+		{
+			int p = grid[x];
+			float capacity = p != PT_NONE
+				? ps.mass[p] * 1000 * sim->type_of(p).specific_heat_cap : 0.0f;
+			// particles that can't hold heat (walls, negative masses)
+			// don't take part, like empty cells
+			if (capacity <= 0)
+			{
+				temperature[row + x] = 0.0f;
+				conductivity[row + x] = 0.0f;
+				inv_capacity[row + x] = 0.0f;
+				occupied[row + x] = 0.0f;
+				continue;
+			}
+			temperature[row + x] = ps.temperature[p];
+			conductivity[row + x] = sim->type_of(p).thermal_cond * sim->heat_coef;
+			inv_capacity[row + x] = 1 / capacity;
+			occupied[row + x] = 1.0f;
+		}
+		if (implicit)
+			std::copy(temperature.begin() + row, temperature.begin() + row + sim->cells_x_count, guess.begin() + row);
+	}
+}
+
+void Heat::conduct_rows(int y0, int y1)
+{
+	const int offsets[8] = { -stride - 1, -stride, -stride + 1, -1, 1, stride - 1, stride, stride + 1 };
+	simd_float zero = simd_set(0.0f), top = simd_set(10000.0f);
+	for (int y = y0; y < y1; y++)
+	{
+		int row = (y + 1) * stride;
+		// the padding is empty, so the last vector can run past the grid
+		for (int x = 1; x < stride - 1; x += SIMD_WIDTH)
+		{
+			int idx = row + x;
+			simd_float ta = simd_load(&temperature[idx]);
+			simd_float ka = simd_load(&conductivity[idx]);
+			simd_float heat = zero;
+			for (int off : offsets)
+			{
+				// the hotter cell of the pair sets the conductivity,
+				// only one of the two terms is non zero
+				simd_float d = simd_sub(ta, simd_load(&temperature[idx + off]));
+				simd_float flow = simd_add(simd_mul(simd_max(d, zero), ka),
+					simd_mul(simd_min(d, zero), simd_load(&conductivity[idx + off])));
+				heat = simd_add(heat, simd_mul(flow, simd_load(&occupied[idx + off])));
+			}
+			simd_float tn = simd_sub(ta, simd_mul(heat, simd_load(&inv_capacity[idx])));
+			simd_store(&next[idx], simd_max(simd_min(tn, top), zero));
+		}
+	}
+}
+
+void Heat::solve_rows(int y0, int y1)
+{
+	const int offsets[8] = { -stride - 1, -stride, -stride + 1, -1, 1, stride - 1, stride, stride + 1 };
+	simd_float zero = simd_set(0.0f), one = simd_set(1.0f);
+	for (int y = y0; y < y1; y++)
+	{
+		int row = (y + 1) * stride;
+		for (int x = 1; x < stride - 1; x += SIMD_WIDTH)
+		{
+			int idx = row + x;
+			simd_float ta = simd_load(&temperature[idx]);
+			simd_float ka = simd_load(&conductivity[idx]);
+			simd_float sum_g = zero, sum_gt = zero;
+			for (int off : offsets)
+			{
+				// the conductivity of the pair is picked from the temperatures
+				// at the start of the tick, the lower one for a tie
+				// so both cells see the same one
+				simd_float tb = simd_load(&temperature[idx + off]);
+				simd_float kb = simd_load(&conductivity[idx + off]);
+				simd_float g = simd_select(simd_greater(ta, tb), ka,
+					simd_select(simd_greater(tb, ta), kb, simd_min(ka, kb)));
+				g = simd_mul(g, simd_load(&occupied[idx + off]));
+				sum_g = simd_add(sum_g, g);
+				sum_gt = simd_add(sum_gt, simd_mul(g, simd_load(&guess[idx + off])));
+			}
+			// C (T' - T) = sum g (T'b - T'), solved for T'
+			simd_float ca = simd_load(&inv_capacity[idx]);
+			simd_float tn = simd_div(simd_add(ta, simd_mul(ca, sum_gt)), simd_add(one, simd_mul(ca, sum_g)));
+			simd_store(&next[idx], tn);
+		}
+	}
+}
+
+void Heat::scatter_rows(int y0, int y1)
+{
+	ParticleStore& ps = sim->particles;
+	for (int y = y0; y < y1; y++)
+	{
+		const int* grid = &sim->elements_grid[y * sim->cells_x_count];
+		int row = (y + 1) * stride + 1;
+		for (int x = 0; x < sim->cells_x_count; x++)
+		{
+			int p = grid[x];
+			if (occupied[row + x] == 0 || next[row + x] == temperature[row + x])
+				continue;
+			if (fabsf(next[row + x] - ps.temperature[p]) > CHUNK_HEAT_EPS)
+				sim->chunks.wake(x, y);
+			ps.temperature[p] = next[row + x];
+		}
+	}
+}
+
+void Heat::resize()
+{
+	int width = (sim->cells_x_count + SIMD_WIDTH - 1) / SIMD_WIDTH * SIMD_WIDTH;
+	stride = width + 2;
+	rows = sim->cells_y_count + 2;
+	temperature.assign(stride * rows, 0.0f);
+	conductivity.assign(stride * rows, 0.0f);
+	inv_capacity.assign(stride * rows, 0.0f);
+	occupied.assign(stride * rows, 0.0f);
+	next.assign(stride * rows, 0.0f);
+	guess.assign(stride * rows, 0.0f);
+}
+
+Heat::Heat(Simulation* sim) :
+	sim(sim)
+{
+	resize();
+}
+
+Heat::~Heat()
+{
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <vector>
+#include <stdint.h>
+
+class Simulation;
+
+// Conduction between neighbouring particles, computed over the whole
+// grid at once. Every pair of touching particles exchanges heat from
+// the hotter to the colder one, at the conductivity of the hotter one.
+// The exchanges all use the temperatures from the start of the pass,
+// so the order of the particles doesn't matter and whatever
+// a particle gives away its neighbour receives.
+// The grid is split in bands, a row of chunks each. Only the bands
+// with an awake chunk and the ones next to them are conducted,
+// the cells of the others count as empty.
+class Heat
+{
+public:
+	Simulation* sim;
+	// Solves for the temperatures at the end of the tick (backward
+	// Euler) instead of stepping from the ones at its start. It stays
+	// stable however large heat_coef and the conductivities are,
+	// so equilibrium can be reached in a few ticks
+	bool implicit = false;
+	// Jacobi iterations of the implicit solver per tick
+	int iterations = 8;
+	// Conducts heat for one tick and wakes the particles it warmed
+	void update();
+	void resize();
+	Heat(Simulation* sim);
+	~Heat();
+private:
+	// The arrays hold the grid with an empty border of a cell,
+	// rows are padded to a whole amount of SIMD vectors
+	int stride, rows;
+	std::vector<float> temperature;
+	// Thermal conductivity times the heat coefficient
+	std::vector<float> conductivity;
+	// Temperature change per unit of heat
+	std::vector<float> inv_capacity;
+	// 1 for the cells holding a particle that can hold heat,
+	// 0 for the others
+	std::vector<float> occupied;
+	std::vector<float> next;
+	// Temperatures of the previous Jacobi iteration
+	std::vector<float> guess;
+	// Whether every band is conducted this tick
+	std::vector<uint8_t> band_active;
+	// Copies the particles of grid rows y0 to y1 into the arrays
+	void gather_rows(int y0, int y1);
+	void conduct_rows(int y0, int y1);
+	// One Jacobi iteration from guess into next
+	void solve_rows(int y0, int y1);
+	// Writes the new temperatures back to the particles
+	void scatter_rows(int y0, int y1);
+};
@@ -3,9 +3,9 @@
 
 void HeatTool::do_action(int x, int y, int element_id, Simulation* sim, float strength)
 {
-	std::shared_ptr<Element> el = sim->get_from_grid(x, y);
-	if(el != EL_NONE)
-		el->add_heat(strength * 10000);
+	int p = sim->get_from_grid(x, y);
+	if(p != PT_NONE)
+		sim->element_of(p)->add_heat(p, strength * 10000);
 }
 
 
@@ -4,3 +4,4 @@
 #define TL_NEGP 4
 #define TL_POSP 5
 #define TL_SPWN 6
+#define TL_COUNT 7
@@ -1,6 +1,8 @@
 #include "Simulation.h"
 #include <algorithm>
+#include <thread>
 #include "Element/Elements/GOL.h"
+#include "Element/ElementRegistry.h"
 #include "Utils/Vector.h"
 
 bool Simulation::check_if_empty(Vector cordinates) const
@@ -17,7 +19,7 @@ bool Simulation::check_if_empty(int x, int y) const
 {
 	bool res = false;
 	if (bounds_check(x, y))
-		res = elements_grid[IDX(x, y, cells_x_count)] == EL_NONE;
+		res = elements_grid[IDX(x, y, cells_x_count)] == PT_NONE;
 	return res;
 }
 
@@ -35,70 +37,92 @@ bool Simulation::check_id(int x, int y, int id) const
 {
 	bool res = false;
 	if (bounds_check(x, y) && !check_if_empty(x, y))
-		res = elements_grid[IDX(x, y, cells_x_count)]->identifier == id;
+		res = particles.type[elements_grid[IDX(x, y, cells_x_count)]] == id;
 	return res;
 }
 
-std::shared_ptr<Element> Simulation::get_from_grid(Vector cordinates) const
+int Simulation::get_from_grid(Vector cordinates) const
 {
 	return get_from_grid(cordinates.x, cordinates.y);
 }
 
-std::shared_ptr<Element> Simulation::get_from_grid(float x, float y) const
+int Simulation::get_from_grid(float x, float y) const
 { 
 	return get_from_grid(static_cast<int>(floor(x)), static_cast<int>(floor(y)));
 }
 
-std::shared_ptr<Element> Simulation::get_from_grid(int x, int y) const
+int Simulation::get_from_grid(int x, int y) const
 {
-	std::shared_ptr<Element> res = nullptr;
+	int res = PT_NONE;
 	if (bounds_check(x, y))
 		res = elements_grid[IDX(x, y, cells_x_count)];
 	return res;
 }
 
-int Simulation::get_from_gol(Vector cordinates) const
+Element* Simulation::element_of(int p) const
 {
-	return get_from_gol(cordinates.x, cordinates.y);
+	return elements[particles.type[p]].get();
 }
 
-int Simulation::get_from_gol(float x, float y) const
+int Simulation::update_particle(int p, float dt)
 {
-	return get_from_gol(static_cast<int>(floor(x)), static_cast<int>(floor(y)));
+	int id = particles.type[p];
+	return element_visit(id, elements[id].get(), [p, dt](auto el)
+	{
+		return el->update(p, dt);
+	});
 }
 
-int Simulation::get_from_gol(int x, int y) const
+void Simulation::collision_response(int p)
 {
-	int res = -1;
-	if (bounds_check(x, y))
-		res = gol_grid[IDX(x, y, cells_x_count)];
-	return res;
+	int id = particles.type[p];
+	element_visit(id, elements[id].get(), [p](auto el)
+	{
+		el->collision_response(p);
+	});
 }
 
-void Simulation::set_gol_at(int x, int y, int val)
+const ElementType& Simulation::type_of(int p) const
 {
-	if (bounds_check(x, y))
-		gol_grid[IDX(x, y, cells_x_count)] = val;
+	return element_types[particles.type[p]];
+}
+
+void Simulation::update_life_cell(int idx)
+{
+	// nobody reads the boards while there are no GOL particles
+	if (life_stale)
+		return;
+	if (ThreadPool::worker >= 0)
+	{
+		life_changes[ThreadPool::worker].push_back(idx);
+		return;
+	}
+	int p = elements_grid[idx];
+	life.set_cell(idx % cells_x_count, idx / cells_x_count,
+		p != PT_NONE ? particles.type[p] : EL_NONE_ID);
 }
 
-std::shared_ptr<Element> Simulation::find_by_id(int id)
+Element* Simulation::find_by_id(int id) const
 {
-	std::shared_ptr<Element> match = nullptr;
-	match = std::dynamic_pointer_cast<Element>(find_simObject_byId(id, available_elements));
+	Element* match = nullptr;
+	if (id >= 0 && id < EL_COUNT)
+		match = elements[id].get();
 	return match;
 }
 
-std::shared_ptr<Brush> Simulation::find_brush_by_id(int id)
+std::shared_ptr<Brush> Simulation::find_brush_by_id(int id) const
 {
 	std::shared_ptr<Brush> match = nullptr;
-	match = std::dynamic_pointer_cast<Brush>(find_simObject_byId(id, brushes));
+	if (id >= 0 && static_cast<size_t>(id) < brushes.size())
+		match = brushes[id];
 	return match;
 }
 
-std::shared_ptr<Tool> Simulation::find_tool_by_id(int id)
+std::shared_ptr<Tool> Simulation::find_tool_by_id(int id) const
 {
 	std::shared_ptr<Tool> match = nullptr;
-	match = std::dynamic_pointer_cast<Tool>(find_simObject_byId(id, tools));
+	if (id >= 0 && id < TL_COUNT)
+		match = tools[id];
 	return match;
 }
 
@@ -107,45 +131,174 @@ void Simulation::tick(bool bypass_pause, float dt)
 	fps = 1 / dt;
 	if (paused && !bypass_pause)
 		return;
-	for (int i = 0; i < cells_y_count; i++)
+	if (gol_count > 0)
 	{
-		for (int j = 0; j < cells_x_count; j++)
+		// the boards are only rebuilt when the first GOL particles show up
+		if (life_stale)
 		{
-			gol_grid[IDX(j, i, cells_x_count)] = elements_grid[IDX(j, i, cells_x_count)] != EL_NONE ? 1 : 0;
+			life.rebuild(*this);
+			life_stale = false;
 		}
+		life.step(*this);
 	}
 
-	active_elements.erase(
-		std::remove_if(active_elements.begin(), active_elements.end(), 
-		[this, dt](std::shared_ptr<Element> const& el) -> bool
+	chunks.begin_tick();
+	sort_by_chunk();
+	ticking = true;
+	if (workers.get_thread_count() > 1 && can_split_tick())
+	{
+		// the chunks of a pass are two apart so nothing
+		// their particles touch overlaps
+		split_tick = true;
+		for (int pass = 0; pass < 4; pass++)
 		{
-			bool destroyed = el == EL_NONE;
-			if (!destroyed)
+			pass_chunks.clear();
+			for (int cy = pass / 2; cy < chunks.height; cy += 2)
 			{
-				int id = el->update(dt);
-				if(id != el->identifier)
-				{	
-					if (id != EL_NONE_ID)
-						transition_element(el, id);
-					else
-						destroy_element(el, false);
-					destroyed = true;
+				for (int cx = pass % 2; cx < chunks.width; cx += 2)
+				{
+					int c = cy * chunks.width + cx;
+					if (chunk_start[c] != chunk_start[c + 1] && !chunks.chunks[c].active.empty())
+						pass_chunks.push_back(c);
 				}
 			}
-			return destroyed;
-		}), 
-		active_elements.end()
-	);
-	for (auto& add_el : add_queue)
+			workers.run(static_cast<int>(pass_chunks.size()), [this, dt](int i)
+			{
+				update_chunk(pass_chunks[i], dt);
+			});
+		}
+		split_tick = false;
+	}
+	else
 	{
-		active_elements.push_back(add_el);
+		workers.run(1, [this, dt](int)
+		{
+			for (size_t c = 0; c < chunks.chunks.size(); c++)
+				update_chunk(static_cast<int>(c), dt);
+		});
+	}
+	heat.update();
+	air.apply_deposits();
+	chunks.merge_deferred();
+
+	// the particles that are left, still sorted by chunk,
+	// followed by the ones created since the last tick
+	active_elements.clear();
+	for (int p : chunk_particles)
+	{
+		if (p == PT_NONE)
+			continue;
+		particles.list_slot[p] = static_cast<int>(active_elements.size());
+		active_elements.push_back(p);
+	}
+	auto append = [this](std::vector<int>& queue)
+	{
+		for (int p : queue)
+		{
+			if (p == PT_NONE)
+				continue;
+			particles.flags[p] &= ~PF_QUEUED;
+			particles.list_slot[p] = static_cast<int>(active_elements.size());
+			active_elements.push_back(p);
+		}
+		queue.clear();
+	};
+	append(add_queue);
+	for (auto& queue : worker_queues)
+		append(queue);
+	ticking = false;
+	// the boards go stale once the last GOL particle is gone
+	if (gol_count == 0)
+		life_stale = true;
+	for (auto& changes : life_changes)
+	{
+		for (int idx : changes)
+			update_life_cell(idx);
+		changes.clear();
 	}
-	add_queue.clear();
 	if (neut_grav)
-		gravity.update_grav();
-	air.update_air();
-	if (air.ambient_heat)
-		air.update_airh();
+	{
+		gravity.deposit_mass();
+		// the forces change everywhere
+		if (gravity.update_grav())
+			chunks.wake_all();
+	}
+	air.update();
+}
+
+void Simulation::sort_by_chunk()
+{
+	// counting sort, the particles of a chunk keep their order
+	std::fill(chunk_start.begin(), chunk_start.end(), 0);
+	for (int p : active_elements)
+		if (p != PT_NONE)
+			chunk_start[chunks.index_of(particles.x[p], particles.y[p]) + 1]++;
+	for (size_t c = 1; c < chunk_start.size(); c++)
+		chunk_start[c] += chunk_start[c - 1];
+	chunk_particles.resize(chunk_start.back());
+	// the starts are used as cursors, leaving each
+	// of them at the start of the next chunk
+	for (int p : active_elements)
+	{
+		if (p == PT_NONE)
+			continue;
+		int& slot = chunk_start[chunks.index_of(particles.x[p], particles.y[p])];
+		particles.list_slot[p] = slot;
+		chunk_particles[slot++] = p;
+	}
+	for (size_t c = chunk_start.size() - 1; c > 0; c--)
+		chunk_start[c] = chunk_start[c - 1];
+	chunk_start[0] = 0;
+}
+
+void Simulation::update_chunk(int c, float dt)
+{
+	for (int i = chunk_start[c]; i < chunk_start[c + 1]; i++)
+	{
+		int p = chunk_particles[i];
+		if (p == PT_NONE)
+			continue;
+		int x = particles.x[p], y = particles.y[p];
+		// particles of sleeping chunks are left as they are,
+		// the ones pushed out of the chunk by a swap wait
+		// for the next tick so they don't reach too far
+		if (!chunks.is_active(x, y) || chunks.index_of(x, y) != c)
+			continue;
+		int id = update_particle(p, dt);
+		if (id != particles.type[p])
+		{
+			chunk_particles[i] = PT_NONE;
+			if (id != EL_NONE_ID)
+				transition_element(p, id);
+			else
+				destroy_particle(p, false);
+		}
+	}
+}
+
+bool Simulation::can_split_tick() const
+{
+	// a particle touches cells up to CHUNK_MAX_MOVE + 4 away from
+	// its chunk, an air cell that doesn't line up with the chunks
+	// or is bigger than half of one could be reached from two
+	// chunks of the same pass. Gravity masses are deposited after
+	// the passes, so its cells don't matter here
+	return CHUNK_SIZE % air.cell_size == 0 && air.cell_size <= CHUNK_SIZE / 2;
+}
+
+void Simulation::set_thread_count(int count)
+{
+	count = std::clamp(count, 1, 64);
+	workers.set_thread_count(count);
+	chunks.set_worker_count(count);
+	air.set_deposit_count(count);
+	worker_queues.resize(count);
+	life_changes.resize(count);
+}
+
+int Simulation::get_thread_count() const
+{
+	return workers.get_thread_count();
 }
 
 void Simulation::render(sf::RenderWindow* window)
@@ -155,11 +308,11 @@ void Simulation::render(sf::RenderWindow* window)
 	if (active_elements.size() > 0)
 	{
 		int quad_i = 0;
-		for (auto &el : active_elements)
+		for (int p : active_elements)
 		{
-			if (el != EL_NONE)
+			if (p != PT_NONE)
 			{
-				el->render(cell_height, cell_width, &cells_vertices[quad_i * 4]);
+				element_of(p)->render(p, cell_height, cell_width, &cells_vertices[quad_i * 4]);
 				quad_i++;
 			}
 		}
@@ -170,7 +323,7 @@ void Simulation::render(sf::RenderWindow* window)
 		if(drav_grid == 1)
 			window->draw(draw_grid(gravity.grav_grid, gravity.cell_size, gravity.grid_height, gravity.grid_width));
 		if(drav_grid == 2)
-			window->draw(draw_grid(air.velocity, air.cell_size, air.grid_height, air.grid_width));
+			window->draw(draw_grid(air.get_velocities(), air.cell_size, air.grid_height, air.grid_width));
 
 	}
 	sf::Vertex quad[4];
@@ -198,82 +351,85 @@ void Simulation::render(sf::RenderWindow* window)
 }
 
 
-int Simulation::get_gol_neigh_count(int corr_x, int corr_y) const
-{
-	int count = 0;
-	// Moore neighborhood is used
-	for (int i = -1 + corr_y; i < 2 + corr_y; i++)
-	{
-		for (int j = -1 + corr_x; j < 2 + corr_x; j++)
-		{
-			// Only 1 in the gol_grid is considered alive
-			if (bounds_check(j, i) && (i != corr_y || j != corr_x) 
-				&& gol_grid[IDX(j, i, cells_x_count)] == 1)
-			{
-				// ignoring self
-				count++;
-			}
-		}
-	}
-	return count;
-}
-
-
 bool Simulation::bounds_check(int corr_x, int corr_y) const
 {
 	return (corr_x >= 0 && corr_x < cells_x_count) && (corr_y >= 0 && corr_y < cells_y_count);
 }
 
-std::shared_ptr<Element> Simulation::create_element(int id, bool fm, bool ata, int idx)
+int Simulation::create_element(int id, bool fm, bool ata, int idx)
 {
 	return create_element(id, fm, ata, idx % cells_x_count, idx / cells_x_count);
 }
 
-std::shared_ptr<Element> Simulation::create_element(int id, bool fm, bool ata, int x, int y)
+int Simulation::create_element(int id, bool fm, bool ata, int x, int y)
 {
 	// If the element at the position is None_Element (id == 0)
 	if (bounds_check(x, y) && check_if_empty(x, y))
 	{
 		int idx = IDX(x, y, cells_x_count);
-		std::shared_ptr<Element> new_element;
-		std::shared_ptr<Element> tmp;
+		Element* tmp;
 		id = fm ? selected_element : id;
 		tmp = find_by_id(id);
-		if (tmp)
-			new_element = std::move(tmp->clone());
-		else
-			return EL_NONE;
-		new_element->set_pos(x, y, true);
-		new_element->sim = this;
+		if (!tmp)
+			return PT_NONE;
+		int p;
+		{
+			std::lock_guard<std::mutex> lock(particle_mutex);
+			p = particles.create(id, x, y);
+			if (p == PT_NONE)
+				return PT_NONE;
+			elements_count++;
+			if (element_types[id].gol)
+				gol_count++;
+		}
+		tmp->init_particle(p);
+		if (particles.state[p] == ST_SOLID)
+			air.set_solid(x, y, true);
 
-		if (ata)
-			active_elements.push_back(new_element);
+		// the active list is rebuilt at the end of a tick,
+		// so particles created meanwhile wait in a queue
+		if (ata && !ticking)
+		{
+			particles.list_slot[p] = static_cast<int>(active_elements.size());
+			active_elements.push_back(p);
+		}
 		else
-			add_queue.push_back(new_element);
+		{
+			// during a tick every worker has its own queue
+			int worker = ThreadPool::worker;
+			std::vector<int>& queue = worker >= 0 ? worker_queues[worker] : add_queue;
+			particles.flags[p] |= PF_QUEUED;
+			particles.list_queue[p] = static_cast<int8_t>(worker >= 0 ? worker : -1);
+			particles.list_slot[p] = static_cast<int>(queue.size());
+			queue.push_back(p);
+		}
 
-		elements_grid[idx] = new_element;
-		elements_count++;
-		gravity.update_mass(new_element->mass, x, y, -1, -1);
-		return new_element;
+		elements_grid[idx] = p;
+		update_life_cell(idx);
+		chunks.wake(x, y);
+		return p;
 	}
-	return EL_NONE;
+	return PT_NONE;
 }
 // for now it will only set the previous id and temperature
 // of the new element
-void Simulation::transition_element(const std::shared_ptr<Element> el, int id)
-{
-	int x = el->x, y = el->y;
-	float temp = el->temperature;
-	int old_id = el->identifier;
-	destroy_element(x, y, false);
-	std::shared_ptr<Element> tmp = create_element(id, false, false, x, y);
-	tmp->temperature = temp;
-	tmp->previous_id = old_id;
+void Simulation::transition_element(int p, int id)
+{
+	int x = particles.x[p], y = particles.y[p];
+	float temp = particles.temperature[p];
+	int old_id = particles.type[p];
+	destroy_particle(p, false);
+	int tmp = create_element(id, false, false, x, y);
+	if (tmp != PT_NONE)
+	{
+		particles.temperature[tmp] = temp;
+		particles.previous_id[tmp] = old_id;
+	}
 }
 
-void Simulation::destroy_element(const std::shared_ptr<Element> destroyed, bool dfa)
+void Simulation::destroy_particle(int p, bool dfa)
 {
-	destroy_element(destroyed->x, destroyed->y, dfa);
+	destroy_element(particles.x[p], particles.y[p], dfa);
 }
 
 void Simulation::destroy_element(int x, int y, bool dfa)
@@ -281,18 +437,39 @@ void Simulation::destroy_element(int x, int y, bool dfa)
 	if (bounds_check(x, y) && !check_if_empty(x, y))
 	{
 		int idx = IDX(x, y, cells_x_count);
+		int p = elements_grid[idx];
 		if (dfa)
 		{
-			for (auto& el : active_elements)
-				if (el != EL_NONE && el->x == x && el->y == y)
-				{
-					el = EL_NONE;
-					break;
-				}
+			// the slot might be reused right away so it
+			// can't be left behind in any of the lists,
+			// the hole is removed during the next tick
+			int slot = particles.list_slot[p];
+			if (particles.flags[p] & PF_QUEUED)
+			{
+				int worker = particles.list_queue[p];
+				(worker >= 0 ? worker_queues[worker] : add_queue)[slot] = PT_NONE;
+			}
+			else if (ticking)
+			{
+				chunk_particles[slot] = PT_NONE;
+			}
+			else
+			{
+				active_elements[slot] = PT_NONE;
+			}
 		}
-		gravity.update_mass(elements_grid[idx]->mass, -1, -1, x, y);
-		elements_grid[idx] = EL_NONE;
-		elements_count--;
+		if (particles.state[p] == ST_SOLID)
+			air.set_solid(x, y, false);
+		elements_grid[idx] = PT_NONE;
+		{
+			std::lock_guard<std::mutex> lock(particle_mutex);
+			if (element_types[particles.type[p]].gol)
+				gol_count--;
+			particles.destroy(p);
+			elements_count--;
+		}
+		update_life_cell(idx);
+		chunks.wake(x, y);
 	}
 }
 
@@ -300,21 +477,42 @@ bool Simulation::add_element(std::shared_ptr<Element> tba)
 {
 	// should think what to do about gol elements
 	// prob. should inherit the main gol class and be other types of elements
-	if (tba->identifier != EL_GOL)
+	int id = tba->identifier;
+	if (id > EL_NONE_ID && id < EL_COUNT && id != EL_GOL && !elements[id])
 	{
-		return add_simObject(tba, available_elements);
+		elements[id] = tba;
+		element_types[id].gol = dynamic_cast<GOL*>(tba.get()) != nullptr;
+		if (element_types[id].gol)
+			life.add_element(id);
+		return true;
 	}
 	return false;
 }
 
 bool Simulation::add_brush(std::shared_ptr<Brush> tba)
 {
-	return add_simObject(tba, brushes);
+	// brushes don't have generated identifiers
+	// so the table grows to fit them
+	int id = tba->identifier;
+	if (id < 0)
+		return false;
+	if (static_cast<size_t>(id) >= brushes.size())
+		brushes.resize(id + 1);
+	if (brushes[id])
+		return false;
+	brushes[id] = tba;
+	return true;
 }
 
 bool Simulation::add_tool(std::shared_ptr<Tool> tba)
 {
-	return add_simObject(tba, tools);
+	int id = tba->identifier;
+	if (id > 0 && id < TL_COUNT && !tools[id])
+	{
+		tools[id] = tba;
+		return true;
+	}
+	return false;
 }
 
 void Simulation::select_brush(int brushId)
@@ -343,6 +541,9 @@ void Simulation::clear_field()
 			destroy_element(x, y);
 		}
 	}
+	// only holes are left in the lists
+	active_elements.clear();
+	add_queue.clear();
 }
 
 void Simulation::set_cell_count(int x_count, int y_count)
@@ -353,16 +554,34 @@ void Simulation::set_cell_count(int x_count, int y_count)
 		clear_field();
 		cells_x_count = x_count;
 		cells_y_count = y_count;
-		gol_grid.resize(x_count * y_count);
-		elements_grid.assign(x_count * y_count, EL_NONE);
+		life.resize(x_count, y_count);
+		life_stale = true;
+		elements_grid.assign(x_count * y_count, PT_NONE);
+		chunks.resize(x_count, y_count);
+		reserve_particles();
 		air.resize();
 		gravity.resize();
+		heat.resize();
 		cell_width = window_width / static_cast<float>(x_count);
 		cell_height = window_height / static_cast<float>(y_count);
 		mouse_calibrate();
 	}
 }
 
+void Simulation::reserve_particles()
+{
+	// there is at most one particle per cell
+	int capacity = cells_x_count * cells_y_count;
+	particles.set_capacity(capacity);
+	active_elements.clear();
+	active_elements.reserve(capacity);
+	add_queue.clear();
+	add_queue.reserve(capacity);
+	chunk_particles.reserve(capacity);
+	chunk_start.assign(chunks.chunks.size() + 1, 0);
+	pass_chunks.reserve(chunks.chunks.size());
+}
+
 void Simulation::set_window_size(int window_w, int window_h)
 {
 	m_window_width = window_w;
@@ -370,33 +589,6 @@ void Simulation::set_window_size(int window_w, int window_h)
 	mouse_calibrate();
 }
 
-bool Simulation::add_simObject(std::shared_ptr<SimObject> object, std::vector<std::shared_ptr<SimObject>>& container)
-{
-	for (auto ob : container)
-	{
-		if (object->identifier == ob->identifier)
-		{
-			return false;
-		}
-	}
-	container.push_back(object);
-	return true;
-}
-
-std::shared_ptr<SimObject> Simulation::find_simObject_byId(int id, std::vector<std::shared_ptr<SimObject>>& vector)
-{
-	std::shared_ptr<SimObject> match = nullptr;
-	for (auto& ob : vector)
-	{
-		if (ob->identifier == id)
-		{
-			match = ob;
-			break;
-		}
-	}
-	return match;
-}
-
 void Simulation::mouse_calibrate()
 {
 	if (cells_x_count && cells_y_count)
@@ -409,11 +601,23 @@ void Simulation::swap_elements(int x1, int y1, int x2, int y2)
 {
 	//Prob will add more stuff then just this but for now...
 	int idx1 = IDX(x1, y1, cells_x_count), idx2 = IDX(x2, y2, cells_x_count);
-	elements_grid[idx2].swap(elements_grid[idx1]);
-	if(elements_grid[idx2] != EL_NONE)
-		elements_grid[idx2]->set_pos(x2, y2, false);
-	if(elements_grid[idx1] != EL_NONE)
-		elements_grid[idx1]->set_pos(x1, y1, false);
+	std::swap(elements_grid[idx1], elements_grid[idx2]);
+	update_life_cell(idx1);
+	update_life_cell(idx2);
+	if(elements_grid[idx2] != PT_NONE)
+		particles.set_pos(elements_grid[idx2], x2, y2, false);
+	if(elements_grid[idx1] != PT_NONE)
+		particles.set_pos(elements_grid[idx1], x1, y1, false);
+	// a solid carried along takes its obstacle with it
+	bool solid1 = elements_grid[idx1] != PT_NONE && particles.state[elements_grid[idx1]] == ST_SOLID;
+	bool solid2 = elements_grid[idx2] != PT_NONE && particles.state[elements_grid[idx2]] == ST_SOLID;
+	if (solid1 != solid2)
+	{
+		air.set_solid(x1, y1, solid1);
+		air.set_solid(x2, y2, solid2);
+	}
+	chunks.wake(x1, y1);
+	chunks.wake(x2, y2);
 }
 
 
@@ -449,20 +653,29 @@ void Simulation::resize_brush(float d)
 
 Simulation::Simulation(int x_count, int y_count, int window_w, int window_h, float base_g) :
 	elements_count(0),
-	gol_grid(y_count * x_count, 0),
-	elements_grid(y_count * x_count, EL_NONE),
-	cell_width(window_w / static_cast<float>(x_count)),
-	cell_height(window_h / static_cast<float>(y_count)),
 	cells_x_count(x_count),
 	cells_y_count(y_count),
+	gravity(this, 10000, 25, 8, base_g, 1E-3f),
+	air(this, 4, 295.15f, 4),
+	heat(this),
+	chunks(x_count, y_count),
+	life(x_count, y_count),
+	element_types(EL_COUNT),
+	baseUI(),
+	cell_height(window_h / static_cast<float>(y_count)),
+	cell_width(window_w / static_cast<float>(x_count)),
 	window_height(window_h),
 	window_width(window_w),
 	m_window_height(window_h),
 	m_window_width(window_w),
-	air(this, 4, 295.15f, 4),
-	gravity(this, 10000, 25, 8, base_g, 1E-3f),
-	baseUI()
+	elements_grid(y_count * x_count, PT_NONE),
+	elements(EL_COUNT),
+	tools(TL_COUNT),
+	workers(1)
 { 
+	reserve_particles();
+	set_thread_count(static_cast<int>(std::thread::hardware_concurrency()));
+	register_elements(*this);
 	mouse_calibrate();
 	selected_element = EL_NONE_ID;
 }
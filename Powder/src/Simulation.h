@@ -1,15 +1,21 @@
 #pragma once
 #include <vector>
 #include <list>
+#include <mutex>
 
 #include "Element/Element.h"
 #include "Element/ElementsIds.h"
+#include "Element/ParticleStore.h"
+#include "Element/ChunkGrid.h"
+#include "Element/LifeEngine.h"
 #include "SimTool/Tool.h"
 #include "SimTool/ToolsIds.h"
 #include "UI/BaseUI.h" 
 #include "Brushes/Brush.h"
 #include "Physics/Gravity.h"
 #include "Physics/Air.h"
+#include "Physics/Heat.h"
+#include "Utils/ThreadPool.h"
 
 class Vector;
 
@@ -27,6 +33,20 @@ public:
 	float scale = 1.f;
 	Gravity gravity;
 	Air air;
+	// Conduction between the particles
+	Heat heat;
+	ParticleStore particles;
+	// Keeps track of the parts of the grid that need updating
+	ChunkGrid chunks;
+	// Set while the chunks of a checkerboard pass run on several threads,
+	// the particles can't move further than CHUNK_MAX_MOVE meanwhile
+	bool split_tick = false;
+	// Runs the GOL elements once per tick.
+	// Kept up to date by create_element, destroy_element and swap_elements
+	// while GOL particles exist, stale otherwise
+	LifeEngine life;
+	// The constants of every element, indexed by the identifier
+	std::vector<ElementType> element_types;
 	BaseUI baseUI;
 	bool neut_grav = false;
 	// Set in the ui, used to know which grid to draw
@@ -38,39 +58,46 @@ public:
 	bool check_id(Vector cordinates, int id) const;
 	bool check_id(float x, float y, int id) const;
 	bool check_id(int x, int y, int id) const;
-	std::shared_ptr<Element> get_from_grid(Vector cordinates) const;
-	std::shared_ptr<Element> get_from_grid(float x, float y) const;
-	std::shared_ptr<Element> get_from_grid(int x, int y) const;
-	int get_from_gol(Vector cordinates) const;
-	int get_from_gol(float x, float y) const;
-	int get_from_gol(int x, int y) const;
-	// Gets all the alive neighbours of a cell
-	// with position x and y
-	// Uses the gol_grid
-	int get_gol_neigh_count(int x, int y) const;
-	void set_gol_at(int x, int y, int val);
-	std::shared_ptr<Element> find_by_id(int id);
-	std::shared_ptr<Brush> find_brush_by_id(int id);
-	std::shared_ptr<Tool> find_tool_by_id(int id);
-	// Updates the gol grid.
+	// Returns the index of the particle at the position
+	// or PT_NONE if the cell is empty or out of bounds
+	int get_from_grid(Vector cordinates) const;
+	int get_from_grid(float x, float y) const;
+	int get_from_grid(int x, int y) const;
+	// Returns the element describing the behaviour of the particle p
+	Element* element_of(int p) const;
+	// Call the methods of the particle's element without going
+	// through the vtable, see ElementRegistry.h
+	int update_particle(int p, float dt);
+	void collision_response(int p);
+	// Returns the constants of the element the particle p belongs to
+	const ElementType& type_of(int p) const;
+	// Return nullptr if nothing is registered under the id
+	Element* find_by_id(int id) const;
+	std::shared_ptr<Brush> find_brush_by_id(int id) const;
+	std::shared_ptr<Tool> find_tool_by_id(int id) const;
 	// Loops over all the active elements and calls their update method.
 	// If the update method returns true, then the elements is deleted.
 	// Adds any newly created elements to the active list.
+	// The chunks are updated in four passes of a checkerboard,
+	// the chunks of a pass are spread over the threads
 	void tick(bool bypass_pause = false, float dt = 1);
+	// Amount of threads used for updating the particles
+	void set_thread_count(int count);
+	int get_thread_count() const;
 	// Loops over all the active elements and calls their render method.
 	// Renders the grid(NOT YET IMPLEMENTED) and the outline of the spawn area
 	void render(sf::RenderWindow* window);
-	// Creates element inside the grid and returns a pointer towards it
+	// Creates element inside the grid and returns the index of its particle
 	//
 	// bool from_mouse = whether the creation is called by the mouse
 	// or from another existing element
 	// int id = the identifier of the element to be created
 	// bool add_to_active = whether the elements needs to be added to the active list
 	// int x, y = the position of the element in the grid
-	std::shared_ptr<Element> create_element(int id, bool from_mouse, bool add_to_active, int x, int y);
-	std::shared_ptr<Element> create_element(int id, bool from_mouse, bool add_to_active, int idx);
-	void transition_element(const std::shared_ptr<Element> el, int id);
-	void destroy_element(const std::shared_ptr<Element> destroyed, bool destroy_from_active = true);
+	int create_element(int id, bool from_mouse, bool add_to_active, int x, int y);
+	int create_element(int id, bool from_mouse, bool add_to_active, int idx);
+	void transition_element(int p, int id);
+	void destroy_particle(int p, bool destroy_from_active = true);
 	void destroy_element(int x, int y, bool destroy_from_active = true);
 	void swap_elements(int x1, int y1, int x2, int y2);
 	// Checks if the possition at x and y
@@ -87,6 +114,7 @@ public:
 	// Based on the currently used spawn area type the creation method is called
 	// Spanw area types include circle, square, triangle NOTE: currently only cirlce is implemented 
 	void resize_brush(float d);
+	// Return false if the identifier is invalid or already taken
 	bool add_element(std::shared_ptr<Element>);
 	bool add_brush(std::shared_ptr<Brush>);
 	bool add_tool(std::shared_ptr<Tool>);
@@ -112,22 +140,55 @@ private:
 	std::weak_ptr<Brush> selected_brush;
 	std::weak_ptr<Tool> selected_tool;
 	friend class BaseUI;
+	friend class Gravity;
+	friend class Heat;
 	int mouse_x = 0, mouse_y = 0;
-	std::vector<std::shared_ptr<Element>> elements_grid;
-	// Used for GoL simulation
-	// 1 is alive 0 is dead, anything else varies
-	// of the specific GoL element
-	std::vector<int> gol_grid; 
-	// All the available elements that can be spawned
-	std::vector<std::shared_ptr<SimObject>> available_elements;
-	std::vector<std::shared_ptr<SimObject>> brushes;
-	std::vector<std::shared_ptr<SimObject>> tools;
-	// All currently active elements inside the element grid
-	std::vector<std::shared_ptr<Element>> active_elements;
-	// Elements that need to be added to the active list
-	std::vector<std::shared_ptr<Element>> add_queue;
-	bool add_simObject(std::shared_ptr<SimObject> object, std::vector<std::shared_ptr<SimObject>>& container);
-	std::shared_ptr<SimObject> find_simObject_byId(int id, std::vector<std::shared_ptr<SimObject>>& list);
+	// Index of the particle in each cell, PT_NONE if the cell is empty
+	std::vector<int> elements_grid;
+	bool life_stale = true;
+	// Alive particles of elements derived from GOL
+	int gol_count = 0;
+	// Cells changed by each worker during a tick, the boards of
+	// the LifeEngine are shared by the workers so they're
+	// only updated once the tick is over
+	std::vector<std::vector<int>> life_changes;
+	// All the available elements, brushes and tools indexed by
+	// their identifier, unregistered identifiers are nullptr.
+	// The elements are also used to dispatch the particles
+	std::vector<std::shared_ptr<Element>> elements;
+	std::vector<std::shared_ptr<Brush>> brushes;
+	std::vector<std::shared_ptr<Tool>> tools;
+	// All currently active particles inside the element grid
+	std::vector<int> active_elements;
+	// Particles that need to be added to the active list
+	std::vector<int> add_queue;
+	// Particles created by each worker during a tick,
+	// added to the active list after add_queue
+	std::vector<std::vector<int>> worker_queues;
+	// The active list sorted by chunk at the start of a tick,
+	// the particles of chunk c are in [chunk_start[c], chunk_start[c + 1]).
+	// Particles that leave the simulation are set to PT_NONE
+	std::vector<int> chunk_start;
+	std::vector<int> chunk_particles;
+	// Set from the sort by chunk until the active list is rebuilt,
+	// the particles are then tracked in chunk_particles
+	bool ticking = false;
+	// Chunks of the current checkerboard pass
+	std::vector<int> pass_chunks;
+	ThreadPool workers;
+	// Guards the free list of the particle store and elements_count
+	std::mutex particle_mutex;
 	void mouse_calibrate();
+	// Sizes the particle store and the lists for the current cell count
+	void reserve_particles();
+	// Sorts the active list into chunk_particles
+	void sort_by_chunk();
+	// Updates the particles of the chunk that are inside its active rect
+	void update_chunk(int c, float dt);
+	// Passes the particle now in the cell to the LifeEngine
+	void update_life_cell(int idx);
+	// Whether the air cells are small enough that
+	// chunks two apart never share one of them
+	bool can_split_tick() const;
 	sf::VertexArray draw_grid(std::vector<Vector> velocities, int cell_size, int  height, int width);
 };
\ No newline at end of file
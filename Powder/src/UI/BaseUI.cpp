@@ -41,11 +41,22 @@ void BaseUI::show_simulation_settings(Simulation* sim)
 	ImGui::SetNextWindowSize(ImVec2(430, 295), ImGuiCond_FirstUseEver);
 	if (ImGui::Begin("Simulation settings", NULL))
 	{
+		// set when something that changes the behaviour
+		// of the particles is edited
+		bool changed = false;
 		ImGui::PushItemWidth(200);
 		if (ImGui::CollapsingHeader("Simulation specific"))
 		{
-			ImGui::InputFloat("Scale", &(sim->scale), 0.01f, 1.0f);
-			ImGui::InputFloat("Heat coef", &(sim->heat_coef), 0.1f, 1.f);
+			changed |= ImGui::InputFloat("Scale", &(sim->scale), 0.01f, 1.0f);
+			changed |= ImGui::InputFloat("Heat coef", &(sim->heat_coef), 0.1f, 1.f);
+			changed |= ImGui::Checkbox("Implicit heat", &(sim->heat.implicit));
+			if (sim->heat.implicit)
+				ImGui::InputInt("Heat iterations", &(sim->heat.iterations), 1, 4);
+			int thread_count = sim->get_thread_count();
+			if (ImGui::InputInt("Threads", &thread_count, 1, 1, ImGuiInputTextFlags_EnterReturnsTrue))
+			{
+				sim->set_thread_count(thread_count);
+			}
 			ImGui::Checkbox("Show element_menu", &show_em);
 			ImGui::Checkbox("Show simulation overlay", &show_so);
 			int cell_size[2] = { sim->cells_x_count, sim->cells_y_count };
@@ -60,6 +71,7 @@ void BaseUI::show_simulation_settings(Simulation* sim)
 			{
 				sim->clear_field();
 			}
+			ImGui::SliderInt("GOL generations per tick (log2)", &(sim->life.hashlife_speed), 0, 10);
 			if (ImGui::Button("New element editor"))
 			{
 				el_editor_queue.push_back(ElementEditor());
@@ -69,16 +81,22 @@ void BaseUI::show_simulation_settings(Simulation* sim)
 		{
 			if (ImGui::Checkbox("Neutownian gravity", &(sim->neut_grav)))
 			{
+				changed = true;
 				if (sim->neut_grav == false)
 					sim->gravity.clear_field();
 				else
 					sim->gravity.changed = true;
 			}
-			ImGui::InputFloat("G", &(sim->gravity.G), 0.01f, 1.0f);
-			float old_th = sim->gravity.mass_th;
+			if (ImGui::Combo("Solver", &(sim->gravity.solver), "Direct\0FFT\0\0"))
+			{
+				changed = true;
+				sim->gravity.changed = true;
+			}
+			ImGui::Checkbox("Update on a thread", &(sim->gravity.async));
+			changed |= ImGui::InputFloat("G", &(sim->gravity.G), 0.01f, 1.0f);
 			if(ImGui::InputFloat("Mass threshold", &(sim->gravity.mass_th), 1.0f, 100.0f))
 			{
-				sim->gravity.set_mass_th(old_th);
+				sim->gravity.set_mass_th();
 			}
 			if(ImGui::InputInt("Cell size", &(sim->gravity.cell_size), 1, 10))
 			{
@@ -87,22 +105,33 @@ void BaseUI::show_simulation_settings(Simulation* sim)
 			if (ImGui::InputFloat("Base gravity", &(sim->gravity.base_g), 0.01f, 0.1f))
 			{
 				sim->gravity.set_baseG();
+				changed = true;
 			}
 		}
 		if (ImGui::CollapsingHeader("Air"))
 		{
-			ImGui::Combo("Air mode", &(sim->air.air_mode), "No update\0Pressure off\0Velocity off\0Off\0On\0\0");
-			ImGui::Checkbox("Ambient heat", &(sim->air.ambient_heat));
-			ImGui::InputFloat("Ambient air temperature", &(sim->air.amb_air_temp), 0.1f, 1.0f, "%.2f");
-			ImGui::InputFloat("Ambient air special heat coef", &(sim->air.air_shc), 0.001f, 0.01f);
-			ImGui::InputFloat("Ambient air thermal conductivity heat coef", &(sim->air.air_tc), 0.001f, 0.01f);
-			ImGui::InputFloat("Pressure time step", &(sim->air.air_tstepp), 0.01f, 0.1f);
-			ImGui::InputFloat("Velocity time step", &(sim->air.air_tstepv), 0.01f, 0.1f);
-			ImGui::InputFloat("Air advection coef", &(sim->air.air_vadv), 0.01f, 0.1f);
-			ImGui::InputFloat("Velocity loss", &(sim->air.air_vloss), 0.001f, 0.1f);
-			ImGui::InputFloat("Pressure loss", &(sim->air.air_ploss), 0.001f, 0.1f);
+			changed |= ImGui::Combo("Air mode", &(sim->air.air_mode), "No update\0Pressure off\0Velocity off\0Off\0On\0\0");
+			int air_threads = sim->air.get_thread_count();
+			if (ImGui::InputInt("Air threads", &air_threads, 1, 1, ImGuiInputTextFlags_EnterReturnsTrue))
+			{
+				sim->air.set_thread_count(air_threads);
+			}
+			changed |= ImGui::Checkbox("Ambient heat", &(sim->air.ambient_heat));
+			changed |= ImGui::InputFloat("Ambient air temperature", &(sim->air.amb_air_temp), 0.1f, 1.0f, "%.2f");
+			changed |= ImGui::InputFloat("Ambient air special heat coef", &(sim->air.air_shc), 0.001f, 0.01f);
+			changed |= ImGui::InputFloat("Ambient air thermal conductivity heat coef", &(sim->air.air_tc), 0.001f, 0.01f);
+			changed |= ImGui::InputFloat("Pressure time step", &(sim->air.air_tstepp), 0.01f, 0.1f);
+			changed |= ImGui::InputFloat("Velocity time step", &(sim->air.air_tstepv), 0.01f, 0.1f);
+			changed |= ImGui::InputFloat("Air advection coef", &(sim->air.air_vadv), 0.01f, 0.1f);
+			changed |= ImGui::InputFloat("Velocity loss", &(sim->air.air_vloss), 0.001f, 0.1f);
+			changed |= ImGui::InputFloat("Pressure loss", &(sim->air.air_ploss), 0.001f, 0.1f);
 		}
 		ImGui::PopItemWidth();
+		if (changed)
+		{
+			sim->chunks.wake_all();
+			sim->air.wake_all();
+		}
 	}
 	ImGui::End();
 }
@@ -113,25 +142,28 @@ void BaseUI::show_simulation_overlay(Simulation* sim)
 
 	ImGui::SetNextWindowPos(ImVec2(dist, dist), ImGuiCond_FirstUseEver, ImVec2(0.0f, 0.0f));
 	ImGui::SetNextWindowBgAlpha(0.8f);
-	Element* hovered_el;
+	int hovered_el;
 	if (ImGui::Begin("Overlay", NULL, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav))
 	{
-		hovered_el = &*(sim->get_from_grid(sim->mouse_cell_x, sim->mouse_cell_y));
+		hovered_el = sim->get_from_grid(sim->mouse_cell_x, sim->mouse_cell_y);
 		ImGui::Text("Mouse Position: (%d, %d), ", sim->mouse_cell_x,
 			sim->mouse_cell_y); ImGui::SameLine();
 		ImGui::Text("%s, ", sim->paused ? "Paused" : "Running"); ImGui::SameLine();
 		ImGui::Text("FPS: %.1f, ", sim->fps); ImGui::SameLine();
-		ImGui::Text("Element count: %d", sim->elements_count);
+		ImGui::Text("Element count: %d, ", sim->elements_count); ImGui::SameLine();
+		ImGui::Text("Awake chunks: %d/%d", sim->chunks.awake_count(),
+			static_cast<int>(sim->chunks.chunks.size()));
 		float temperature;
 		float pressure;
 		Vector air_velocity;
 		const char* name;
-		if(hovered_el != EL_NONE)
+		if(hovered_el != PT_NONE)
 		{
-			temperature = hovered_el->temperature;
-			name = hovered_el->name.c_str();
-			pressure = sim->air.get_pressure(hovered_el->x, hovered_el->y);
-			air_velocity = sim->air.get_force(hovered_el->x, hovered_el->y);
+			const ParticleStore& ps = sim->particles;
+			temperature = ps.temperature[hovered_el];
+			name = sim->element_of(hovered_el)->name.c_str();
+			pressure = sim->air.get_pressure(ps.x[hovered_el], ps.y[hovered_el]);
+			air_velocity = sim->air.get_force(ps.x[hovered_el], ps.y[hovered_el]);
 		}
 		else 
 		{
@@ -166,8 +198,10 @@ void BaseUI::show_element_menu(Simulation* sim)
 		int i = 0;
 		ImGui::PushStyleColor(ImGuiCol_FrameBg, ImVec4(0.31f, 0.31f, 0.31f, 1));
 		ImGui::BeginChildFrame(ImGui::GetID("brushes"), ImVec2(70, -1));
-		for (auto br : sim->brushes)
+		for (auto& br : sim->brushes)
 		{
+			if (!br)
+				continue;
 			int id = br->scrollable_display(i == selected_br);
 			if (id == 0)
 			{
@@ -184,8 +218,10 @@ void BaseUI::show_element_menu(Simulation* sim)
 		ImGui::BeginChildFrame(ImGui::GetID("elements"), ImVec2(80, -1));
 		if (ImGui::CollapsingHeader("Elems##header"))
 		{
-			for (auto el : sim->available_elements)
+			for (auto& el : sim->elements)
 			{
+				if (!el)
+					continue;
 				int id = el->scrollable_display(i == selected_el);
 				if (id != -1)
 				{
@@ -197,7 +233,7 @@ void BaseUI::show_element_menu(Simulation* sim)
 					}
 					else
 					{
-						el_editor_queue.emplace_back(static_cast<Element *>(&*el));
+						el_editor_queue.emplace_back(el.get());
 					}
 				}
 				i++;
@@ -206,9 +242,9 @@ void BaseUI::show_element_menu(Simulation* sim)
 		i = 0;
 		if (ImGui::CollapsingHeader("Tools##header"))
 		{
-			for (auto tl : sim->tools)
+			for (auto& tl : sim->tools)
 			{
-				if (tl->identifier != TL_SPWN)
+				if (tl && tl->identifier != TL_SPWN)
 				{
 					int id = tl->scrollable_display(i == selected_tl);
 					if (id == 0)
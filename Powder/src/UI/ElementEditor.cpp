@@ -12,16 +12,32 @@ bool ElementEditor::draw(int id, Simulation* sim)
 		ImGui::SetNextWindowSize(ImVec2(355, 365), ImGuiCond_FirstUseEver);
 		if (ImGui::Begin(title.c_str(), &open, ImGuiWindowFlags_NoSavedSettings))
 		{
+			int p = PT_NONE;
+			if (s_part != PH_NONE)
+			{
+				p = sim->particles.resolve(s_part);
+				// the particle was destroyed since it was selected
+				if (p == PT_NONE)
+					detach();
+			}
 			if (s_el != EL_NONE)
 			{
 				ImGui::Text("Selected: %s element.", s_el->name.c_str());
 				ImGui::TextWrapped("Description: %s.", s_el->description.c_str());
-				ImGui::Text("Velocity (%f, %f), ", s_el->velocity.x, s_el->velocity.y);
-				ImGui::Text("Pos (%d, %d), Real pos(%f, %f)", s_el->x, s_el->y,
-					s_el->pos.x, s_el->pos.y);
+				if (p != PT_NONE)
+				{
+					const ParticleStore& ps = sim->particles;
+					ImGui::Text("Velocity (%f, %f), ", ps.vel_x[p], ps.vel_y[p]);
+					ImGui::Text("Pos (%d, %d), Real pos(%f, %f)", ps.x[p], ps.y[p],
+						ps.pos_x[p], ps.pos_y[p]);
+				}
 				ImGui::Separator();
 				ImGui::PushItemWidth(ImGui::GetFontSize() * -12);
-				s_el->draw_ui();
+				edited = false;
+				s_el->draw_ui(p, this);
+				// the element constants are shared by all the particles
+				if (edited)
+					sim->chunks.wake_all();
 			}
 			else
 			{
@@ -30,11 +46,11 @@ bool ElementEditor::draw(int id, Simulation* sim)
 					selecting_el = ImGui::Button("NONE");
 				else
 				{
-					Element* hovered = &*(sim->get_from_grid(sim->mouse_cell_x, sim->mouse_cell_y));
-					ImGui::Text("%s", hovered ? hovered->name.c_str() : "None");
-					if (ImGui::IsMouseClicked(1))
+					int hovered = sim->get_from_grid(sim->mouse_cell_x, sim->mouse_cell_y);
+					ImGui::Text("%s", hovered != PT_NONE ? sim->element_of(hovered)->name.c_str() : "None");
+					if (ImGui::IsMouseClicked(1) && hovered != PT_NONE)
 					{
-						attach(hovered);
+						attach(sim->element_of(hovered), hovered);
 					}
 
 				}
@@ -66,6 +82,7 @@ bool ElementEditor::string_prop(std::string& prop, const char* l, ElementEditorF
 			changed = true;
 	}
 	process_flags_a(flags);
+	edited |= changed;
 	return changed;
 }
 
@@ -82,6 +99,7 @@ bool ElementEditor::float_prop(float& prop, const char* l, float step, float ste
 		changed = true;
 	process_flags_a(flags);
 	draw_plot(prop, flags, -20, 20);
+	edited |= changed;
 	return changed;
 }
 
@@ -98,6 +116,7 @@ bool ElementEditor::int_prop(int& prop, const char* l, int step, int step_fast,
 		changed = true;
 	process_flags_a(flags);
 	draw_plot(static_cast<float>(prop), flags);
+	edited |= changed;
 	return changed;
 }
 
@@ -110,19 +129,33 @@ bool ElementEditor::bool_prop(bool& prop, const char* l, ElementEditorFlags flag
 	if (ImGui::Checkbox(label, &prop))
 		changed = true;
 	process_flags_a(flags);
+	edited |= changed;
 	return changed;
 }
 
 
-bool ElementEditor::attach(Element* attacheble)
+bool ElementEditor::attach(Element* attacheble, int particle)
 {
 	bool status = false;
-	if (attacheble && s_el == EL_NONE && attacheble->editor == nullptr)
+	if (attacheble && s_el == EL_NONE)
 	{
-		selecting_el = false;
-		s_el = attacheble;
-		s_el->editor = this;
-		status = true;
+		// particles can be edited by several editors at once,
+		// their editors find out they died through the handle
+		if (particle != PT_NONE)
+		{
+			selecting_el = false;
+			s_el = attacheble;
+			s_part = attacheble->sim->particles.handle(particle);
+			status = true;
+		}
+		else if (attacheble->editor == nullptr)
+		{
+			selecting_el = false;
+			s_el = attacheble;
+			s_part = PH_NONE;
+			attacheble->editor = this;
+			status = true;
+		}
 	}
 	return status;
 }
@@ -132,8 +165,10 @@ bool ElementEditor::detach()
 	bool status = false;
 	if (s_el != EL_NONE)
 	{
-		s_el->editor = nullptr;
+		if (s_part == PH_NONE)
+			s_el->editor = nullptr;
 		s_el = EL_NONE;
+		s_part = PH_NONE;
 		status = true;
 	}
 	return status;
@@ -150,7 +185,9 @@ ElementEditor::ElementEditor() :
 	plot_count(0),
 	max_plot_count(0),
 	selecting_el(false),
-	s_el(nullptr)
+	edited(false),
+	s_el(nullptr),
+	s_part(PH_NONE)
 {
 }
 
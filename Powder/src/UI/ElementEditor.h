@@ -2,6 +2,8 @@
 #include <imgui.h>
 #include <imgui-SFML.h>
 #include <vector>
+#include "Element/ElementsIds.h"
+#include "Element/ParticleHandle.h"
 enum ElementEditorFlags : uint8_t
 {
 	NoFlags = 0,
@@ -68,12 +70,14 @@ class ElementEditor
 {
 public:
 	Element* s_el;
+	// The edited particle, PH_NONE when the element itself is edited
+	ParticleHandle s_part;
     bool draw(int id, Simulation* sim);
 	bool string_prop(std::string& prop, const char* label, ElementEditorFlags flags = NoFlags);
 	bool float_prop(float& prop, const char* label, float step, float step_fast, ElementEditorFlags flags = NoFlags);
 	bool int_prop(int& prop, const char* label, int step, int step_fast, ElementEditorFlags flags = NoFlags);
 	bool bool_prop(bool& prop, const char* labell, ElementEditorFlags flags = NoFlags);
-	bool attach(Element* attacheble);
+	bool attach(Element* attacheble, int particle = PT_NONE);
 	bool detach();
 	ElementEditor(Element* attacheble);
 	ElementEditor();
@@ -89,6 +93,8 @@ private:
 	};
 
 	bool selecting_el;
+	// Set by the prop methods when a value is changed
+	bool edited;
 	int prop_count;
 	int plot_count;
 	int max_plot_count;
@@ -0,0 +1,77 @@
+#include "Utils/FFT.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+void FFT::transform_2d(std::vector<std::complex<float>>& data, int width, int height, bool inverse)
+{
+	int largest = std::max(width, height);
+	if (static_cast<int>(twiddles.size()) < largest / 2)
+	{
+		twiddles.resize(largest / 2);
+		for (int k = 0; k < largest / 2; k++)
+		{
+			// computed in double so the error doesn't grow with the size
+			double angle = -2.0 * 3.14159265358979323846 * k / largest;
+			twiddles[k] = std::complex<float>(static_cast<float>(cos(angle)), static_cast<float>(sin(angle)));
+		}
+	}
+	for (int y = 0; y < height; y++)
+		transform(&data[y * width], width, inverse);
+	column.resize(height);
+	for (int x = 0; x < width; x++)
+	{
+		for (int y = 0; y < height; y++)
+			column[y] = data[y * width + x];
+		transform(column.data(), height, inverse);
+		for (int y = 0; y < height; y++)
+			data[y * width + x] = column[y];
+	}
+	if (inverse)
+	{
+		float scale = 1.0f / (static_cast<float>(width) * height);
+		for (auto& value : data)
+			value *= scale;
+	}
+}
+
+int FFT::size_for(int n)
+{
+	int size = 1;
+	while (size < n)
+		size <<= 1;
+	return size;
+}
+
+void FFT::transform(std::complex<float>* data, int n, bool inverse)
+{
+	// bit reversed order first, then the butterflies from the smallest span up
+	for (int i = 1, j = 0; i < n; i++)
+	{
+		int bit = n >> 1;
+		for (; j & bit; bit >>= 1)
+			j ^= bit;
+		j ^= bit;
+		if (i < j)
+			std::swap(data[i], data[j]);
+	}
+	int full = static_cast<int>(twiddles.size()) * 2;
+	for (int len = 2; len <= n; len <<= 1)
+	{
+		int half = len / 2;
+		int stride = full / len;
+		for (int start = 0; start < n; start += len)
+		{
+			for (int k = 0; k < half; k++)
+			{
+				std::complex<float> w = twiddles[k * stride];
+				if (inverse)
+					w = std::conj(w);
+				std::complex<float> a = data[start + k];
+				std::complex<float> b = FFT::multiply(data[start + k + half], w);
+				data[start + k] = a + b;
+				data[start + k + half] = a - b;
+			}
+		}
+	}
+}
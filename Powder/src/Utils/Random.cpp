@@ -1,8 +1,6 @@
 #include "Utils/Random.h"
 #include <chrono>
-
-bool Random::has_next_uint32 = false;
-uint32_t Random::next_uint32_temp = 0;
+#include <thread>
 
 static inline uint64_t rotl(const uint64_t x, int k) 
 {
@@ -103,7 +101,8 @@ bool Random::chance(unsigned int threshold, unsigned int max)
 
 Random::Random()
 {
-	seed(time_based());
+	// threads started during the same millisecond still get different seeds
+	seed(time_based() ^ std::hash<std::thread::id>()(std::this_thread::get_id()));
 }
 
 
@@ -111,4 +110,4 @@ Random::~Random()
 {
 }
 
-Random random;
\ No newline at end of file
+thread_local Random random;
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include "Utils/ThreadPool.h"
+#include <algorithm>
+
+thread_local int ThreadPool::worker = -1;
+
+void ThreadPool::run(int count, const std::function<void(int)>& job)
+{
+	if (count <= 0)
+		return;
+	if (threads.empty() || count == 1)
+	{
+		worker = 0;
+		for (int i = 0; i < count; i++)
+			job(i);
+		worker = -1;
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		this->job = &job;
+		job_count = count;
+		next_index = 0;
+		busy = static_cast<int>(threads.size());
+		generation++;
+	}
+	start_cv.notify_all();
+	worker = 0;
+	work();
+	worker = -1;
+	std::unique_lock<std::mutex> lock(mutex);
+	done_cv.wait(lock, [this] { return busy == 0; });
+	this->job = nullptr;
+}
+
+void ThreadPool::work()
+{
+	int i;
+	while ((i = next_index.fetch_add(1)) < job_count)
+		(*job)(i);
+}
+
+void ThreadPool::thread_loop(int index, unsigned int seen)
+{
+	worker = index;
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			start_cv.wait(lock, [this, seen] { return stopping || generation != seen; });
+			if (stopping)
+				return;
+			seen = generation;
+		}
+		work();
+		std::lock_guard<std::mutex> lock(mutex);
+		if (--busy == 0)
+			done_cv.notify_one();
+	}
+}
+
+void ThreadPool::set_thread_count(int count)
+{
+	count = std::max(count, 1);
+	if (count == get_thread_count())
+		return;
+	stop();
+	for (int i = 1; i < count; i++)
+		threads.emplace_back(&ThreadPool::thread_loop, this, i, generation);
+}
+
+int ThreadPool::get_thread_count() const
+{
+	return static_cast<int>(threads.size()) + 1;
+}
+
+void ThreadPool::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	start_cv.notify_all();
+	for (auto& thread : threads)
+		thread.join();
+	threads.clear();
+	stopping = false;
+}
+
+ThreadPool::ThreadPool(int thread_count) :
+	job(nullptr),
+	job_count(0),
+	next_index(0),
+	busy(0),
+	generation(0),
+	stopping(false)
+{
+	set_thread_count(thread_count);
+}
+
+ThreadPool::~ThreadPool()
+{
+	stop();
+}
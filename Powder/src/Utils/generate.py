@@ -5,6 +5,8 @@ fileDir = os.path.dirname(os.path.realpath('__file__'))
 
 def parse_folder(typ, f, folderPath):
     names = [os.path.splitext(x)[0] for x in map(os.path.basename, glob.iglob(folderPath + '/' + '*.h'))]
+    # same order on every platform, otherwise the identifiers change
+    names.sort(key=str.lower)
     for idx, name in  enumerate(names):
         f.write('#define {0}_{1} {2}\n'.format(typ, name.upper(), idx + 1))
     return names
@@ -15,13 +17,57 @@ def includes(filename, idName, names, baseFolder):
         for name in names:
             f.write('#include \"{1}\\{0}.h\"\n'.format(name, baseFolder))
 
+def registry(filename, includeName, names):
+    with open(filename, 'w') as f:
+        f.write('''#pragma once
+#include <memory>
+#include <type_traits>
+#include "{0}"
+
+// Generated from the Elements folder, every element found there
+// is registered and dispatched through the functions below
+
+// Calls f with the element cast to the class of the identifier.
+// The element classes are final so the calls made through
+// the cast pointer are resolved at compile time
+template <typename F>
+static inline auto element_visit(int id, Element* el, F&& f)
+{{
+	switch (id)
+	{{
+'''.format(includeName))
+        for name in names:
+            f.write('\tcase EL_{0}: return f(static_cast<{1}*>(el));\n'.format(name.upper(), name))
+        f.write('''	default: return f(el);
+	}}
+}}
+
+template <typename T, typename S>
+static inline void register_element(S& sim)
+{{
+	// base classes like GOL can't be spawned
+	if constexpr (!std::is_abstract_v<T>)
+		sim.add_element(std::make_shared<T>(sim));
+}}
+
+// Adds every element to the simulation
+template <typename S>
+static inline void register_elements(S& sim)
+{{
+'''.format())
+        for name in names:
+            f.write('\tregister_element<{0}>(sim);\n'.format(name))
+        f.write('}\n')
+
 def tool_generate(idPath, includePath, toolsPath):
     with open(idPath, 'w') as f:
         names = parse_folder('TL', f, toolsPath)
+        # size of the table indexed by the tool identifiers
+        f.write('#define TL_COUNT {0}\n'.format(len(names) + 1))
     includes(includePath, 'ToolsIds.h', names, 'Tools')
     
 
-def element_generate(idPath, includePath, elementsPath):
+def element_generate(idPath, includePath, registryPath, elementsPath):
     with open(idPath, 'w') as eFile:
         eFile.write('''#pragma once
 #define ST_GAS 0
@@ -39,23 +85,29 @@ static inline int IDX(int x, int y, int w)
 }\n''')
         eFile.write('''//ELEMENT_IDS
 #define EL_NONE nullptr
-#define EL_NONE_ID 0\n''')
+#define EL_NONE_ID 0
+// Particle index of empty cells
+#define PT_NONE -1\n''')
         names = parse_folder('EL', eFile, elementsPath)
+        # size of the tables indexed by the element identifiers
+        eFile.write('#define EL_COUNT {0}\n'.format(len(names) + 1))
         #print(eFile.read())
     includes(includePath, 'ElementsIds.h', names, 'Elements')
+    registry(registryPath, os.path.basename(includePath), names)
 
-def main(elIdFile, elIncFile, tlIdFile, tlIncFile):
+def main(elIdFile, elIncFile, elRegFile, tlIdFile, tlIncFile):
     elementIdPath = os.path.abspath(os.path.realpath(os.path.join(fileDir, '../Element/' + elIdFile)))
     elementsPath = os.path.abspath(os.path.realpath(os.path.join(fileDir, '../Element/Elements/')))
     elementIncludePath = os.path.abspath(os.path.realpath(os.path.join(fileDir, '../Element/' + elIncFile)))
+    elementRegistryPath = os.path.abspath(os.path.realpath(os.path.join(fileDir, '../Element/' + elRegFile)))
 
     toolIdPath = os.path.abspath(os.path.realpath(os.path.join(fileDir, '../SimTool/' + tlIdFile)))
     toolsPath = os.path.abspath(os.path.realpath(os.path.join(fileDir, '../SimTool/Tools/')))
     toolIncludePath = os.path.abspath(os.path.realpath(os.path.join(fileDir, '../SimTool/' + tlIncFile)))
 
-    element_generate(elementIdPath, elementIncludePath, elementsPath)
+    element_generate(elementIdPath, elementIncludePath, elementRegistryPath, elementsPath)
     tool_generate(toolIdPath, toolIncludePath, toolsPath)
 
 if __name__ == "__main__":
     #hardcoded for now, TODO make it with cmd params
-    main('ElementsIds.h', 'ElementIncludes.h', 'ToolsIds.h', 'ToolIncludes.h')
\ No newline at end of file
+    main('ElementsIds.h', 'ElementIncludes.h', 'ElementRegistry.h', 'ToolsIds.h', 'ToolIncludes.h')
\ No newline at end of file